@@ -34,6 +34,7 @@ protected:
     void fetch_next();
 
     void enqueue_split(BranchNode::Split prob_array);
+    void rebuild_queue(BranchHistory::iterator cur);
 };
 
 /// Alias declaration for "best tour" branching.
@@ -57,6 +58,7 @@ public:
 protected:
     void fetch_next();
     void enqueue_split(BranchNode::Split prob_array);
+    void rebuild_queue(BranchHistory::iterator cur);
 
 private:
     static constexpr int BestFreq = 10;
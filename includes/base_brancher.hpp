@@ -11,6 +11,7 @@
 #include "branch_util.hpp"
 
 #include <list>
+#include <unordered_map>
 #include <vector>
 
 namespace CMR {
@@ -36,8 +37,18 @@ public:
     /// Unbranch on \p B and all applicable ancestors to prep next problem.
     void do_unbranch(const BranchNode &B);
 
+    /// Erase the visited node \p done and any ancestors left childless.
+    void reclaim(BranchHistory::iterator done);
+
+    /// Resume a search from \p history, with \p cur the next subproblem.
+    void resume(BranchHistory &history, BranchHistory::iterator cur);
+
+    /// The unvisited nodes and their ancestors.
     const BranchHistory &get_history() { return branch_history; }
 
+    int node_count() const { return total_nodes; } //!< Nodes ever created.
+    int max_depth() const { return deepest; } //!< Greatest node depth.
+
     int verbose = 0;
 
 protected:
@@ -45,9 +56,18 @@ protected:
     /// @param prob_array the pair of child subproblems to be added.
     /// This function shall be implemented to add child subproblems to the
     /// list of problems to be processed in a way that preserves the ordering
-    /// criteria of the node selection rule.
+    /// criteria of the node selection rule. Both shall be put at the front of
+    /// branch_history, and only the unvisited ones queued, since split_prob
+    /// erases children that were pruned when they were created.
     virtual void enqueue_split(BranchNode::Split prob_array) = 0;
 
+    /// Rebuild the queue of subproblems after a call to resume.
+    /// @param cur the subproblem to be returned by the next call to
+    /// next_prob, which shall be left out of the queue.
+    /// This function shall queue every other unvisited node of branch_history
+    /// as if they had been added by enqueue_split.
+    virtual void rebuild_queue(BranchHistory::iterator cur) = 0;
+
     /// Execute variable changes if \p done was just done and \p next is next.
     void common_prep_next(const BranchNode &done, const BranchNode &next);
 
@@ -67,9 +87,25 @@ protected:
     BranchTourFind btour_find;
 
     Executor exec;
+
+    /// The search tree, pruned by reclaim to the nodes still needed.
+    /// Children are always placed before their parent.
     BranchHistory branch_history;
 
     BranchHistory::iterator next_itr;
+
+private:
+    /// Position and number of children in branch_history of a split node.
+    struct Family {
+        BranchHistory::iterator itr;
+        int live_children;
+    };
+
+    /// Families of the nodes with children in branch_history.
+    std::unordered_map<const BranchNode *, Family> families;
+
+    int total_nodes = 1;
+    int deepest = 0;
 };
 
 }
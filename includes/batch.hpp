@@ -0,0 +1,51 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */ /**
+ * @file
+ * @brief Solving batches of TSP instances in one process.
+ */ /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef CMR_BATCH_H
+#define CMR_BATCH_H
+
+#include "solver.hpp"
+#include "lp_util.hpp"
+#include "util.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace CMR {
+
+/// A TSPLIB instance to be solved as part of a batch.
+struct BatchJob {
+    BatchJob() = default;
+    BatchJob(std::string fname, int rand_seed, OutPrefs prefs)
+        : tsp_fname(std::move(fname)), seed(rand_seed), outprefs(prefs) {}
+
+    std::string tsp_fname; //!< Path to the TSPLIB file.
+    int seed = 0; //!< Random seed for the Solver.
+    OutPrefs outprefs; //!< Output preferences for the Solver.
+
+    /// The cut selection preset to use.
+    Solver::CutSel::Presets cut_preset = Solver::CutSel::Presets::Aggressive;
+
+    bool do_price = true; //!< Price edges over the full graph.
+    bool branch = true; //!< Use ABC search, else just a cutting loop.
+};
+
+/// The outcome of solving a BatchJob.
+struct BatchResult {
+    bool solved = false; //!< Was the job run without an exception.
+    LP::PivType piv = LP::PivType::Frac; //!< The final pivot type.
+    double tour_val = 0.0; //!< Length of the best tour found.
+    double time = 0.0; //!< Wall clock time to construct and solve.
+    std::string error; //!< The exception message if !solved.
+};
+
+/// Solve each of \p jobs with its own Solver, up to \p num_threads at once.
+std::vector<BatchResult> solve_batch(const std::vector<BatchJob> &jobs,
+                                     int num_threads);
+
+}
+
+#endif
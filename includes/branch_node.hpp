@@ -60,7 +60,9 @@ struct BranchNode {
     double tourlen; //!< Estimated best tour length for this node.
 
     /// A starting basis for if Status is NeedsPrice or NeedsRecover.
-    LP::Basis::Ptr price_basis;
+    /// It is stored relative to the basis \p parent was split from, and
+    /// only unpacked when the node is examined.
+    LP::BasisDelta price_basis;
     double estimate; //!< The objective value estimate from edge selection.
 
     /// Is this the root problem.
@@ -33,6 +33,10 @@ public:
               const std::vector<Graph::Edge> &edges,
               const std::vector<int> &perm);
 
+    /// Construct from an edge list already permuted into tour order.
+    TourGraph(const std::vector<double> &tour_edges,
+              const std::vector<int> &perm_elist, int ncount);
+
     TourGraph(TourGraph &&T) noexcept;
     TourGraph &operator=(TourGraph &&T) noexcept;
 
@@ -48,10 +52,35 @@ public:
     int node_count() const { return L.ncount; }
 
 private:
+    void build(const std::vector<int> &perm_elist, int ncount);
+
     std::vector<double> d_tour;
     CCtsp_lpgraph L;
 };
 
+/** A TourGraph kept in step with a tour and core edge set.
+ * Separators that are constructed anew at each pivot can share one of these
+ * so that the Concorde graph is only rebuilt when the tour or edges change.
+ */
+class TourGraphCache {
+public:
+    /// Get a TourGraph for the given tour and edges, updating if stale.
+    TourGraph &get(const std::vector<double> &tour_edges,
+                   const std::vector<Graph::Edge> &edges,
+                   const std::vector<int> &perm);
+
+    int build_count() const { return builds; } //!< Number of rebuilds.
+
+private:
+    TourGraph TG;
+
+    std::vector<int> tour_perm; //!< The perm used to build TG.
+    std::vector<int> perm_elist; //!< Core edges in tour order.
+
+    bool built = false;
+    int builds = 0;
+};
+
 /// Management of Concorde lpcut_in linked list.
 class LPcutList {
 public:
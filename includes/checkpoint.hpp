@@ -0,0 +1,82 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */ /**
+ * @file
+ * @brief Checkpoints of an ABC search, for resuming it in a new process.
+ */ /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef CMR_CHECKPOINT_H
+#define CMR_CHECKPOINT_H
+
+#include "branch_node.hpp"
+#include "hypergraph.hpp"
+#include "lp_util.hpp"
+
+#include <string>
+#include <vector>
+
+namespace CMR {
+namespace Data {
+
+/** The state of a Solver at the top of an ABC search loop.
+ * A Checkpoint holds everything needed to rebuild the Solver and continue
+ * the search with the next subproblem: the core edges, the best tour, the
+ * cuts of the LP and pool, the active tour and its basis, and the branch
+ * history. The Instance itself is not stored, and must be reloaded from the
+ * same TSPLIB file.
+ * @remark The file written by write is a versioned binary file of
+ * native-endian integers and doubles, meant to be read back on the same
+ * platform.
+ */
+struct Checkpoint {
+    Checkpoint() = default; //!< Construct an empty Checkpoint.
+
+    /// Load a Checkpoint from the file \p fname written by write.
+    Checkpoint(const std::string &fname);
+
+    /// Write this Checkpoint to \p fname, replacing it only on success.
+    void write(const std::string &fname) const;
+
+    /// Store \p history as the branch history, with \p cur examined next.
+    void set_history(const ABC::BranchHistory &history,
+                     const ABC::BranchNode &cur);
+
+    /// Rebuild the branch history in \p history, setting \p cur to its next
+    /// node.
+    void get_history(ABC::BranchHistory &history,
+                     ABC::BranchHistory::iterator &cur) const;
+
+    std::string probname; //!< The name of the Instance.
+    int seed = 0; //!< The random seed of the Instance.
+    int ncount = 0; //!< The number of nodes in the Instance.
+
+    std::vector<int> core_edges; //!< Ends of the CoreGraph edges, in pairs.
+
+    std::vector<int> best_tour; //!< BestGroup::best_tour_nodes.
+    double best_value = 0.0; //!< BestGroup::min_tour_value.
+
+    Sep::CutImage cuts; //!< The cuts of the LP and the pool.
+
+    std::vector<int> active_tour; //!< The nodes of the active tour.
+    bool tourless = false; //!< Was the CoreLP in tourless mode.
+    LP::Basis active_base; //!< The basis of the active tour.
+
+    /// A BranchNode with its parent and starting basis given by index.
+    struct Node {
+        int ends[2]; //!< BranchNode::ends.
+        int direction; //!< BranchNode::direction.
+        int stat; //!< BranchNode::stat.
+        int parent; //!< Index of BranchNode::parent, or -1 for the root.
+        int depth; //!< BranchNode::depth.
+        int basis; //!< Index of BranchNode::price_basis, or -1 if null.
+        double tourlen; //!< BranchNode::tourlen.
+        double estimate; //!< BranchNode::estimate.
+    };
+
+    std::vector<Node> nodes; //!< The branch history, in order.
+    std::vector<LP::Basis> node_bases; //!< Bases of the nodes that have one.
+    int cur_node = -1; //!< Index of the node to be examined next.
+};
+
+}
+}
+
+#endif
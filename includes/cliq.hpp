@@ -12,7 +12,9 @@
 #include "cut_structs.hpp"
 #include "util.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <utility>
@@ -25,11 +27,39 @@ extern "C" {
 namespace CMR {
 namespace Sep {
 
+/** Does a list of disjoint segments contain a tour index.
+ * @param first the first Segment in the list.
+ * @param last one past the last Segment in the list.
+ * @param sorted if true, the segments are in increasing order and a binary
+ * search is used for all but very short lists.
+ * @param index the tour index to look for.
+ */
+inline bool segs_contain(const Segment *first, const Segment *last,
+                         bool sorted, int index)
+{
+    if (!sorted || last - first <= 4) {
+        for (; first != last; ++first)
+            if (first->contains(index))
+                return true;
+        return false;
+    }
+
+    const Segment *it = std::upper_bound(first, last, index,
+                                         [](int i, const Segment &seg)
+                                         { return i < seg.start; });
+
+    return it != first && (it - 1)->contains(index);
+}
+
 /** Class for storing segment lists representing edges of a hypergraph.
  * A Clique stores a subset of vertices as a list of CMR::Segment objects,
  * where the start and endpoints indicate a range of nodes from a tour.
  * Thus, a Clique is meaningless without a tour from which to be
  * derefrenced.
+ * Unless constructed to preserve the order of a node list, the segments are
+ * sorted by start index with adjacent segments merged, so that the
+ * representation of a vertex set is unique. A hash value and the number of
+ * nodes are computed on construction.
  */
 class Clique {
 public:
@@ -51,11 +81,19 @@ public:
     Clique(const std::vector<int> &nodes, const std::vector<int> &perm,
            bool peserve_order);
 
-    using Ptr = std::shared_ptr<Clique>; //!< shared_ptr alias declaration.
+    /// Construct a Clique from a range of segments, keeping their order.
+    Clique(const Segment *first, const Segment *last)
+        : seglist(first, last) { finalize(false); }
 
     /// How many segments are used to represent the Clique.
     int seg_count() const { return seglist.size(); }
 
+    /// The number of nodes in the Clique.
+    int node_count() const { return nodecount; }
+
+    /// The cached hash value of the segment list.
+    std::size_t hash() const { return hval; }
+
     /// A constant reference to the list of segments in the Clique.
     const std::vector<Segment> &seg_list() const { return seglist; }
 
@@ -63,19 +101,34 @@ public:
     std::vector<int> node_list(const std::vector<int> &saved_tour) const;
 
     bool operator==(const Clique &rhs) const
-        { return seglist == rhs.seglist; } //!< Equality operator.
+        {
+            return hval == rhs.hval && seglist == rhs.seglist;
+        } //!< Equality operator.
 
     /// Returns true iff the Clique contains \p index.
-    bool contains(const int index) const {
-        for (const Segment &seg : seglist)
-            if (seg.contains(index))
-                return true;
-        return false;
-    }
+    bool contains(const int index) const
+        {
+            return segs_contain(seglist.data(),
+                                seglist.data() + seglist.size(),
+                                sorted, index);
+        }
+
+    /// Are the segments in increasing order, allowing binary search.
+    bool is_sorted() const { return sorted; }
 
 private:
+    /// Canonicalize the segment list if \p canonical, then cache stats.
+    void finalize(bool canonical);
+
+    /// Hash value for a list of segments.
+    static std::size_t hash_segs(const Segment *first, const Segment *last);
+
     /// A vector of start and endpoints of tour intervals stored as Segment.
     std::vector<Segment> seglist;
+
+    std::size_t hval = 0; //!< Cached hash of seglist.
+    int nodecount = 0; //!< Total size of the segments in seglist.
+    bool sorted = true; //!< Are the segments in increasing order.
 };
 
 /** Vertex set structure used in tooth inequalities for domino parity cuts.
@@ -98,6 +151,9 @@ public:
           const std::vector<int> &saved_perm,
           const std::vector<int> &current_tour);
 
+    /// Construct a Tooth directly from its root and body.
+    Tooth(const Clique &root, const Clique &body) : sets{{root, body}} {}
+
     /// Constant reference to the defining sets.
     const std::array<Clique, 2> &set_pair() const { return sets; }
 
@@ -117,34 +173,24 @@ private:
 
 namespace std {
 
-/// Partial specialization of std::hash taken from CCtsp_hashclique.
+/// Partial specialization of std::hash returning the cached Clique hash.
 template<>
 struct hash<CMR::Sep::Clique> {
     /// Call operator for hashing a Clique.
     size_t operator()(const CMR::Sep::Clique &clq) const
-        {
-            size_t val = 0;
-
-            for (const CMR::Segment &seg : clq.seg_list())
-                val = (val * 65537) + (seg.start * 4099) + seg.end;
-
-            return val;
-        }
+        { return clq.hash(); }
 };
 
-/// Partial specialization of std::hash from CCtsp_hashdomino.
+/// Partial specialization of std::hash combining the Clique hashes.
 template<>
 struct hash<CMR::Sep::Tooth> {
     /// Call operator for hashing a Tooth.
     size_t operator()(const CMR::Sep::Tooth &T) const
         {
-            size_t val = 0;
+            size_t h0 = T.set_pair()[0].hash();
+            size_t h1 = T.set_pair()[1].hash();
 
-            for (const CMR::Sep::Clique &clq : T.set_pair())
-                for (const CMR::Segment &seg : clq.seg_list())
-                    val = (val * 65537) + (seg.start * 4099) + seg.end;
-
-            return val;
+            return h0 ^ (h1 + 0x9e3779b9 + (h0 << 6) + (h0 >> 2));
         }
 };
 
@@ -153,16 +199,34 @@ struct hash<CMR::Sep::Tooth> {
 namespace CMR {
 namespace Sep {
 
+/// Handle to a Clique stored in a CliqueBank.
+using CliqueId = std::uint32_t;
+
+/// A contiguous range of the Segment objects of a banked Clique.
+struct SegRange {
+    const Segment *first;
+    const Segment *last;
+
+    const Segment *begin() const { return first; }
+    const Segment *end() const { return last; }
+
+    int size() const { return last - first; }
+};
+
 /** Storage of a repository of Cliques, for use in building a HyperGraph.
  * This class is responsible for dispensing and deleting references to Clique
  * objects, for use in the edges of a HyperGraph. The interface allows
- * a Clique to be passed to the CliqueBank. A pointer to the Clique will be
- * added to the bank if one does not exist already, or else the use count
- * of the pointer will be incremented. This pointer is then returned for other
- * use. The Cliques contained
+ * a Clique to be passed to the CliqueBank. The Clique will be
+ * added to the bank if one does not exist already, or else its reference
+ * count will be incremented. A CliqueId for the Clique is then returned for
+ * other use. The Cliques contained
  * therein are meaningless without reference to a fixed tour and perm vector,
  * which shall be used to construct Clique objects and turn them back into
  * lists of nodes or sparse cut rows.
+ * @remark The segments of all Cliques are packed in one buffer, and each id
+ * indexes a slot holding the location and reference count of a Clique. Ids
+ * and slots of deleted Cliques are reused. A SegRange is invalidated by the
+ * next call to add_clique or del_clique.
  */
 class CliqueBank {
 public:
@@ -170,51 +234,107 @@ public:
     CliqueBank(const std::vector<int> &tour, const std::vector<int> &perm);
 
     /// Add a Clique to the bank, and get a reference to it.
-    Clique::Ptr add_clique(const Clique &clq);
+    CliqueId add_clique(const Clique &clq);
 
     /// Construct a Clique in place, add it, and get a reference to it.
-    Clique::Ptr add_clique(const CCtsp_lpclique &cc_cliq,
-                           const std::vector<int> &tour);
+    CliqueId add_clique(const CCtsp_lpclique &cc_cliq,
+                        const std::vector<int> &tour);
 
     /// Construct/add/get a reference to the Clique from endpoints.
-    Clique::Ptr add_clique(int start, int end,
-                           const std::vector<int> &tour);
+    CliqueId add_clique(int start, int end, const std::vector<int> &tour);
 
     /// Construct/add/get a reference to a Clique from a node list.
-    Clique::Ptr add_clique(const std::vector<int> &nodes);
+    CliqueId add_clique(const std::vector<int> &nodes);
 
     /// Add a Clique corresponding to an ordered sequence of nodes.
-    Clique::Ptr add_tour_clique(const std::vector<int> &tour_nodes);
+    CliqueId add_tour_clique(const std::vector<int> &tour_nodes);
 
-    /// Put the pointed Clique in this bank.
-    void steal_clique(Clique::Ptr &clq_ptr, CliqueBank &from_bank);
+    /// Put the referenced Clique in this bank.
+    void steal_clique(CliqueId &id, CliqueBank &from_bank);
 
     /// Decrement the reference count of a Clique, possibly removing it.
-    void del_clique(Clique::Ptr &clq_ptr);
+    void del_clique(CliqueId id);
 
     int size() const
-        { return bank.size(); } //!< The number of unique Cliques in the bank.
+        { return live_count; } //!< The number of unique Cliques in the bank.
+
+    /// The id of \p clq if it is in the bank, else NoClique.
+    CliqueId find(const Clique &clq) const;
 
-    /// Alias declaration for Clique hash table.
-    using CliqueHash = std::unordered_map<Clique, Clique::Ptr>;
+    /// Returns true iff \p clq is currently stored in the bank.
+    bool contains(const Clique &clq) const { return find(clq) != NoClique; }
 
-    using Itr = CliqueHash::iterator;
-    using ConstItr = CliqueHash::const_iterator;
+    /// Returns true iff \p id refers to a Clique currently in the bank.
+    bool live(CliqueId id) const
+        { return id < slots.size() && slots[id].refs > 0; }
 
-    Itr begin() { return bank.begin(); }
-    Itr end() { return bank.end(); }
+    /// The number of references to the Clique \p id.
+    int use_count(CliqueId id) const { return slots[id].refs; }
 
-    ConstItr begin() const { return bank.begin(); }
-    ConstItr end() const { return bank.end(); }
+    /// Upper bound on the ids in use, for sizing arrays indexed by id.
+    int id_bound() const { return slots.size(); }
+
+    /// The segments of the Clique \p id.
+    SegRange seg_list(CliqueId id) const
+        {
+            const Segment *first = seg_arena.data() + slots[id].seg_begin;
+            return SegRange{first, first + slots[id].seg_count};
+        }
+
+    /// Returns true iff the Clique \p id contains the tour index \p index.
+    bool contains(CliqueId id, int index) const
+        {
+            SegRange segs = seg_list(id);
+            return segs_contain(segs.begin(), segs.end(), slots[id].sorted,
+                                index);
+        }
+
+    /// The number of nodes in the Clique \p id.
+    int node_count(CliqueId id) const { return slots[id].nodes; }
+
+    /// A copy of the Clique \p id.
+    Clique get_clique(CliqueId id) const
+        {
+            SegRange segs = seg_list(id);
+            return Clique(segs.begin(), segs.end());
+        }
+
+    /// The literal nodes in the Clique \p id.
+    std::vector<int> node_list(CliqueId id) const;
 
     const std::vector<int> &ref_tour() const { return saved_tour; }
     const std::vector<int> &ref_perm() const { return saved_perm; }
 
+    static constexpr CliqueId NoClique = UINT32_MAX; //!< Null id.
 
 private:
+    /// Location and reference count of a Clique in seg_arena.
+    struct Slot {
+        int seg_begin; //!< Index of the first Segment in seg_arena.
+        int seg_count; //!< Number of segments, or zero for a free slot.
+        int refs; //!< Reference count, zero iff the slot is free.
+        int nodes; //!< Number of nodes in the Clique.
+        bool sorted; //!< Are the segments in increasing order.
+        std::size_t hash; //!< Cached hash of the Clique.
+    };
+
+    /// Does the Clique in slot \p id have the segments of \p clq.
+    bool same_segs(CliqueId id, const Clique &clq) const;
+
+    void compact(); //!< Pack the segments of live cliques in seg_arena.
+
     const std::vector<int> saved_tour; //!< Saved tour for dereferencing.
     const std::vector<int> saved_perm; //!< Permutation vector for saved_tour.
-    CliqueHash bank; //!< Hash table of Clique and Clique::Ptr.
+
+    std::vector<Segment> seg_arena; //!< Segments of all banked cliques.
+    std::vector<Slot> slots; //!< Slot for each id, indexing seg_arena.
+    std::vector<CliqueId> free_ids; //!< Slots available for reuse.
+
+    /// Hash table from Clique hash values to ids.
+    std::unordered_multimap<std::size_t, CliqueId> id_index;
+
+    int live_count; //!< Number of cliques with nonzero refs.
+    int dead_segs; //!< Number of seg_arena entries from freed cliques.
 };
 
 
@@ -234,6 +354,9 @@ public:
     Tooth::Ptr add_tooth(const SimpleTooth &T,
                          const std::vector<int> &tour);
 
+    /// Add a Tooth with root \p root and body \p body, getting a reference.
+    Tooth::Ptr add_tooth(const Clique &root, const Clique &body);
+
     /// Decrement the reference count of a Tooth, possibly deleting it.
     void del_tooth(Tooth::Ptr &T_ptr);
 
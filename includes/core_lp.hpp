@@ -117,6 +117,8 @@ private:
 
     int prev_numrows;
 
+    RowBatch cut_batch; //!< Reusable buffer for rows added by add_cuts.
+
     bool steepest_engaged = false;
 };
 
@@ -68,6 +68,10 @@ public:
     const std::function<double(int, int)> edgelen_func() const
         { return [this](int e0, int e1){ return edgelen(e0, e1); }; }
 
+    /// Write the lengths of the \p count edges at \p edges to \p lens.
+    template <typename EdgeType>
+    void edgelens(const EdgeType *edges, int count, double *lens) const;
+
     int node_count() const { return nodecount; } //!< Number of nodes.
     int seed() const { return random_seed; } //!< Random seed used.
 
@@ -78,14 +82,80 @@ public:
     const std::string &problem_name() const { return pname; }
 
 private:
+    /// Norms for which edgelens has a batch kernel.
+    enum class LenKernel : char {
+        Generic, //!< Fall back to CCutil_dat_edgelen.
+        Euclid, //!< EUC_2D with small integer coordinates.
+        Att, //!< ATT with small integer coordinates.
+    };
+
+    void set_len_kernel(); //!< Choose the LenKernel for the norm of dat.
+
     CCdatagroup dat; //!< The Concorde data structure being managed.
 
     int nodecount;
     int random_seed;
 
     std::string pname;
+
+    LenKernel len_kernel = LenKernel::Generic; //!< Set by set_len_kernel.
 };
 
+/**
+ * For EUC_2D and ATT instances with integer coordinates, the squared
+ * distances are gathered from the coordinate arrays of #dat in one pass and
+ * rounded in a second, contiguous pass. Squared distances between such
+ * coordinates are exact in double precision and std::sqrt is correctly
+ * rounded, so the lengths are identical to those of CCutil_dat_edgelen
+ * whether or not the passes are vectorized. The second pass vectorizes only
+ * if sqrt cannot set errno, e.g. with -fno-math-errno. Other norms use
+ * CCutil_dat_edgelen for each edge.
+ * @tparam EdgeType a type with an `end` array of two node indices.
+ * @param[in] edges the edges to measure.
+ * @param[in] count the number of edges.
+ * @param[out] lens an array of at least \p count entries for the lengths.
+ */
+template <typename EdgeType>
+void Instance::edgelens(const EdgeType *edges, int count, double *lens) const
+{
+    const double *x = dat.x;
+    const double *y = dat.y;
+
+    switch (len_kernel) {
+    case LenKernel::Euclid:
+        for (int k = 0; k < count; ++k) {
+            int i = edges[k].end[0];
+            int j = edges[k].end[1];
+            double t1 = x[i] - x[j];
+            double t2 = y[i] - y[j];
+            lens[k] = t1 * t1 + t2 * t2;
+        }
+
+        for (int k = 0; k < count; ++k)
+            lens[k] = static_cast<int>(std::sqrt(lens[k]) + 0.5);
+        break;
+    case LenKernel::Att:
+        for (int k = 0; k < count; ++k) {
+            int i = edges[k].end[0];
+            int j = edges[k].end[1];
+            double xd = x[i] - x[j];
+            double yd = y[i] - y[j];
+            lens[k] = xd * xd + yd * yd;
+        }
+
+        for (int k = 0; k < count; ++k) {
+            double rij = std::sqrt(lens[k] / 10.0);
+            int tij = static_cast<int>(rij);
+            lens[k] = (tij < rij) ? tij + 1 : tij;
+        }
+        break;
+    default:
+        for (int k = 0; k < count; ++k)
+            lens[k] = edgelen(edges[k].end[0], edges[k].end[1]);
+        break;
+    }
+}
+
 }
 
 namespace Graph {
@@ -161,6 +231,10 @@ struct BestGroup {
     BestGroup(const Instance &inst, Graph::CoreGraph &core_graph,
               const std::string &tourfile);
 
+    /// Use \p tour_nodes as the best tour.
+    BestGroup(const Instance &inst, Graph::CoreGraph &core_graph,
+              std::vector<int> tour_nodes);
+
     /// Binary vector of tour edges.
     std::vector<int> best_tour_edges;
 
@@ -183,9 +257,19 @@ struct SupportGroup {
     SupportGroup(SupportGroup &&SG) noexcept;
     SupportGroup &operator=(SupportGroup &&SG) noexcept;
 
+    /// Update in place to describe a new LP solution over the same edges.
+    void update(const std::vector<Graph::Edge> &edges,
+                const std::vector<double> &lp_x,
+                std::vector<int> &island,
+                int ncount);
+
     bool in_subtour_poly(); //!< Is the graph in the subtour polytope.
 
     std::vector<double> lp_vec; //!< The LP solution vector.
+
+    /// Indices of edges whose lp_vec entry changed in the last update.
+    std::vector<int> changed_edges;
+
     std::vector<int> support_indices; //!< Nonzero entries of lp_vec.
     std::vector<int> support_elist; //!< Node-node elist for nonzero entries.
     std::vector<double> support_ecap; //!< Weights on nonzero entries.
@@ -12,6 +12,7 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <unordered_map>
@@ -33,7 +34,12 @@ struct DualGroup {
         node_pi(std::move(D.node_pi)),
         node_pi_est(std::move(D.node_pi_est)),
         cut_pi(std::move(D.cut_pi)),
-        clique_pi(std::move(D.clique_pi)) {}
+        clique_pi(std::move(D.clique_pi)),
+        degree_pi(std::move(D.degree_pi)),
+        clique_diff(std::move(D.clique_diff)),
+        clique_est_diff(std::move(D.clique_est_diff)),
+        domino_est_diff(std::move(D.domino_est_diff)),
+        neg_removed(D.neg_removed), cut_revision(D.cut_revision) {}
 
     DualGroup &operator=(DualGroup &&D) noexcept
         {
@@ -41,15 +47,68 @@ struct DualGroup {
             node_pi_est = std::move(D.node_pi_est);
             cut_pi = std::move(D.cut_pi);
             clique_pi = std::move(D.clique_pi);
+            degree_pi = std::move(D.degree_pi);
+            clique_diff = std::move(D.clique_diff);
+            clique_est_diff = std::move(D.clique_est_diff);
+            domino_est_diff = std::move(D.domino_est_diff);
+            neg_removed = D.neg_removed;
+            cut_revision = D.cut_revision;
             return *this;
         }
 
+    /// Refresh the duals after the LP solution has changed.
+    void update(bool remove_neg, const LP::Relaxation &relax,
+                const Sep::ExternalCuts &ext_cuts);
+
     std::vector<numtype> node_pi; //!< Dual values for degree constraints.
     std::vector<numtype> node_pi_est; //!< Overestimates of node_pi.
     std::vector<numtype> cut_pi; //!< Dual values for cuts.
 
-    /// Dual values/multiplicities for Cliques.
-    std::unordered_map<Sep::Clique, numtype> clique_pi;
+    /// Dual values/multiplicities for Cliques, keyed by id in the CliqueBank
+    /// of the ExternalCuts used to construct the DualGroup.
+    std::unordered_map<Sep::CliqueId, numtype> clique_pi;
+
+    /// Dual values for degree constraints, without clique contributions.
+    std::vector<numtype> degree_pi;
+
+private:
+    /// Get the degree and cut duals from \p relax.
+    void get_pi(bool remove_neg, const LP::Relaxation &relax,
+                const Sep::ExternalCuts &ext_cuts,
+                std::vector<numtype> &new_degree_pi,
+                std::vector<numtype> &new_cut_pi) const;
+
+    /// Compute all the clique and node values from scratch.
+    void rebuild(bool remove_neg, const LP::Relaxation &relax,
+                 const Sep::ExternalCuts &ext_cuts);
+
+    /// Set node_pi and node_pi_est from degree_pi and the difference arrays.
+    void sum_node_pi(const std::vector<int> &def_tour);
+
+    /// Add \p val to the tour positions of \p segs in \p pos_diff.
+    template <typename SegList>
+    static void add_to_segs(const SegList &segs, numtype val,
+                            std::vector<numtype> &pos_diff);
+
+    /// Add \p val to the tour positions of the teeth of domino \p H.
+    static void add_to_teeth(const Sep::HyperGraph &H, numtype val,
+                             std::vector<numtype> &pos_diff);
+
+    /// The positive part of \p val.
+    static numtype pos_part(numtype val)
+        { return (val > 0.0) ? val : numtype(0.0); }
+
+    /// Difference array over tour positions of clique duals.
+    std::vector<numtype> clique_diff;
+
+    /// Difference array over tour positions of positive clique duals.
+    std::vector<numtype> clique_est_diff;
+
+    /// Difference array over tour positions of positive domino duals.
+    std::vector<numtype> domino_est_diff;
+
+    bool neg_removed = false; //!< The remove_neg value of the last build.
+    int cut_revision = -1; //!< ExternalCuts::cut_revision at the last build.
 };
 
 /**
@@ -65,23 +124,142 @@ struct DualGroup {
 template <typename numtype>
 DualGroup<numtype>::DualGroup(bool remove_neg, const LP::Relaxation &relax,
                               const Sep::ExternalCuts &ext_cuts) try
+{
+    rebuild(remove_neg, relax, ext_cuts);
+} catch (const std::exception &e) {
+    std::cerr << e.what() << "\n";
+    throw std::runtime_error("Problem in DualGroup constructor.");
+}
+
+/**
+ * If the cuts of \p ext_cuts are the ones this DualGroup was last built with,
+ * and \p remove_neg is unchanged, only the cuts whose dual values have
+ * changed are walked: the change in each affected Clique multiplicity is
+ * applied to the cached per-node clique sums, and likewise for the positive
+ * parts of domino duals. Otherwise, or if more than half of the cut duals
+ * have changed, the DualGroup is rebuilt from scratch. The arguments are as
+ * in the constructor.
+ * @remark The incremental path is only taken for exact types such as
+ * util::Fixed64. With floating point duals the deltas would pick up rounding
+ * error across updates, leaving cancelled clique duals slightly nonzero, so
+ * a double DualGroup is always rebuilt.
+ */
+template <typename numtype>
+void DualGroup<numtype>::update(bool remove_neg, const LP::Relaxation &relax,
+                                const Sep::ExternalCuts &ext_cuts) try
 {
     using HyperGraph = Sep::HyperGraph;
     using CutType = HyperGraph::Type;
     using std::vector;
+
+    if (std::is_floating_point<numtype>::value ||
+        remove_neg != neg_removed ||
+        ext_cuts.cut_revision() != cut_revision ||
+        node_pi.size() != ext_cuts.get_cbank().ref_tour().size()) {
+        rebuild(remove_neg, relax, ext_cuts);
+        return;
+    }
+
+    const vector<HyperGraph> &cuts = ext_cuts.get_cuts();
+    const Sep::CliqueBank &clique_bank = ext_cuts.get_cbank();
+
+    vector<numtype> new_degree_pi;
+    vector<numtype> new_cut_pi;
+
+    get_pi(remove_neg, relax, ext_cuts, new_degree_pi, new_cut_pi);
+
+    vector<int> changed;
+
+    for (int i = 0; i < cuts.size(); ++i)
+        if (new_cut_pi[i] != cut_pi[i])
+            changed.push_back(i);
+
+    if (2 * changed.size() > cuts.size()) {
+        rebuild(remove_neg, relax, ext_cuts);
+        return;
+    }
+
+    // old multiplicities of the cliques touched by a changed cut
+    std::unordered_map<Sep::CliqueId, numtype> old_clique_pi;
+
+    for (int i : changed) {
+        const HyperGraph &H = cuts[i];
+        numtype old_pi = cut_pi[i];
+        numtype new_pi = new_cut_pi[i];
+
+        if (H.cut_type() == CutType::Non)
+            throw std::runtime_error("Tried to get_duals with Non cut present.");
+
+        if (H.cut_type() == CutType::Domino) {
+            numtype est_delta = pos_part(new_pi) - pos_part(old_pi);
+            if (est_delta == 0.0)
+                continue;
+
+            add_to_segs(clique_bank.seg_list(H.get_cliques()[0]), est_delta,
+                        domino_est_diff);
+            add_to_teeth(H, est_delta, domino_est_diff);
+            continue;
+        }
+
+        numtype delta = new_pi - old_pi;
+
+        for (Sep::CliqueId id : H.get_cliques()) {
+            numtype &clq_pi = clique_pi[id];
+
+            if (old_clique_pi.count(id) == 0)
+                old_clique_pi[id] = clq_pi;
+
+            clq_pi += delta;
+        }
+    }
+
+    for (const std::pair<const Sep::CliqueId, numtype> &kv : old_clique_pi) {
+        Sep::CliqueId id = kv.first;
+        numtype old_pi = kv.second;
+        numtype new_pi = clique_pi[id];
+
+        if (new_pi == old_pi)
+            continue;
+
+        Sep::SegRange segs = clique_bank.seg_list(id);
+
+        add_to_segs(segs, new_pi - old_pi, clique_diff);
+
+        numtype est_delta = pos_part(new_pi) - pos_part(old_pi);
+        if (est_delta != 0.0)
+            add_to_segs(segs, est_delta, clique_est_diff);
+    }
+
+    cut_pi = std::move(new_cut_pi);
+    degree_pi = std::move(new_degree_pi);
+    sum_node_pi(clique_bank.ref_tour());
+} catch (const std::exception &e) {
+    std::cerr << e.what() << "\n";
+    throw std::runtime_error("Problem in DualGroup::update.");
+}
+
+/**
+ * @param remove_neg if true, cut duals of the wrong sign are set to zero.
+ * @param relax the Relaxation to query.
+ * @param ext_cuts the cuts in \p relax.
+ * @param[out] new_degree_pi the duals of the degree equations.
+ * @param[out] new_cut_pi the duals of the cuts.
+ */
+template <typename numtype>
+void DualGroup<numtype>::get_pi(bool remove_neg, const LP::Relaxation &relax,
+                                const Sep::ExternalCuts &ext_cuts,
+                                std::vector<numtype> &new_degree_pi,
+                                std::vector<numtype> &new_cut_pi) const
+{
+    using HyperGraph = Sep::HyperGraph;
+    using std::vector;
     using std::cout;
     using std::cerr;
-    using std::endl;
 
     vector<double> full_pi;
-    vector<double> d_node_pi;
-    vector<double> d_cut_pi;
 
     const vector<HyperGraph> &cuts = ext_cuts.get_cuts();
-    const Sep::CliqueBank &clique_bank = ext_cuts.get_cbank();
-    const vector<int> &def_tour = clique_bank.ref_tour();
-
-    int node_count = def_tour.size();
+    int node_count = ext_cuts.get_cbank().ref_tour().size();
 
     if (relax.num_rows() != node_count + cuts.size()) {
         cerr << "Relaxation row count: " << relax.num_rows() << ", "
@@ -90,35 +268,55 @@ DualGroup<numtype>::DualGroup(bool remove_neg, const LP::Relaxation &relax,
         throw std::runtime_error("Size mismatch.");
     }
 
-    clique_pi.reserve(clique_bank.size());
     relax.get_pi(full_pi, 0, relax.num_rows() - 1);
 
-    node_pi = vector<numtype>(full_pi.begin(), full_pi.begin() + node_count);
-    node_pi_est = node_pi;
-
-    if (!cuts.empty())
-        cut_pi = vector<numtype>(full_pi.begin() + node_count, full_pi.end());
+    new_degree_pi = vector<numtype>(full_pi.begin(),
+                                    full_pi.begin() + node_count);
+    new_cut_pi = vector<numtype>(full_pi.begin() + node_count, full_pi.end());
 
-    if (node_pi.size() != node_count || cut_pi.size() != cuts.size())
+    if (new_degree_pi.size() != node_count ||
+        new_cut_pi.size() != cuts.size())
         throw std::runtime_error("Node pi or cut pi size mismatch");
 
     if (remove_neg) {
         for (int i = 0; i < cuts.size(); ++i) {
             if (cuts[i].get_sense() == 'G') {
-                if (cut_pi[i] < 0) {
+                if (new_cut_pi[i] < 0) {
                     cout << "\tCorrection: setting >= dual "
-                         << cut_pi[i] << " to zero.\n";
-                    cut_pi[i] = 0;
+                         << new_cut_pi[i] << " to zero.\n";
+                    new_cut_pi[i] = 0;
                 }
             } else if (cuts[i].get_sense() == 'L') {
-                if (cut_pi[i] > 0) {
+                if (new_cut_pi[i] > 0) {
                     cout << "\tCorrection: setting <= dual "
-                         << cut_pi[i] << " to zero.\n";
-                    cut_pi[i] = 0;
+                         << new_cut_pi[i] << " to zero.\n";
+                    new_cut_pi[i] = 0;
                 }
             }
         }
     }
+}
+
+/**
+ * Computes clique_pi from the non-domino cut duals, then the difference
+ * arrays of clique duals and of positive domino duals.
+ */
+template <typename numtype>
+void DualGroup<numtype>::rebuild(bool remove_neg, const LP::Relaxation &relax,
+                                 const Sep::ExternalCuts &ext_cuts)
+{
+    using HyperGraph = Sep::HyperGraph;
+    using CutType = HyperGraph::Type;
+    using std::vector;
+
+    const vector<HyperGraph> &cuts = ext_cuts.get_cuts();
+    const Sep::CliqueBank &clique_bank = ext_cuts.get_cbank();
+    int node_count = clique_bank.ref_tour().size();
+
+    get_pi(remove_neg, relax, ext_cuts, degree_pi, cut_pi);
+
+    clique_pi.clear();
+    clique_pi.reserve(clique_bank.size());
 
     //get clique_pi for non-domino cuts
     for (int i = 0; i < cuts.size(); ++i) {
@@ -132,40 +330,32 @@ DualGroup<numtype>::DualGroup(bool remove_neg, const LP::Relaxation &relax,
 
         numtype pival = cut_pi[i];
 
-        for (const Sep::Clique::Ptr &clq_ref : H.get_cliques()) {
-            if (clique_pi.count(*clq_ref) == 0)
-                clique_pi[*clq_ref] = 0.0;
+        for (Sep::CliqueId id : H.get_cliques()) {
+            if (clique_pi.count(id) == 0)
+                clique_pi[id] = 0.0;
 
-            clique_pi[*clq_ref] += pival;
+            clique_pi[id] += pival;
         }
     }
-    //use clique_pi to build node_pi for all cliques with nonzero pi
-    for (const std::pair<Sep::Clique, numtype> &kv : clique_pi) {
-        const Sep::Clique &clq = kv.first;
+
+    clique_diff.assign(node_count + 1, numtype(0.0));
+    clique_est_diff.assign(node_count + 1, numtype(0.0));
+    domino_est_diff.assign(node_count + 1, numtype(0.0));
+
+    //use clique_pi to build node sums for all cliques with nonzero pi
+    for (const std::pair<const Sep::CliqueId, numtype> &kv : clique_pi) {
         numtype pival = kv.second;
+        Sep::SegRange segs = clique_bank.seg_list(kv.first);
 
         if (pival > 0.0) {
-            for (const Segment &seg : clq.seg_list()) {
-                for (int k = seg.start; k <= seg.end; ++k) {
-                    int node = def_tour[k];
-
-                    node_pi[node] += pival;
-                    node_pi_est[node] += pival;
-                }
-            }
+            add_to_segs(segs, pival, clique_diff);
+            add_to_segs(segs, pival, clique_est_diff);
         } else if (pival < 0.0) {
-            for (const Segment &seg : clq.seg_list()) {
-                for (int k = seg.start; k <= seg.end; ++k) {
-                    int node = def_tour[k];
-
-                    node_pi[node] += pival;
-                }
-            }
+            add_to_segs(segs, pival, clique_diff);
         }
     }
 
-
-    //now get node_pi_est for domino cuts, skipping standard ones
+    //now get node sums for domino cuts, skipping standard ones
     for (int i = 0; i < cuts.size(); ++i) {
         const HyperGraph &H = cuts[i];
         if (H.cut_type() != CutType::Domino)
@@ -175,28 +365,70 @@ DualGroup<numtype>::DualGroup(bool remove_neg, const LP::Relaxation &relax,
         if (pival <= 0.0)
             continue;
 
-        const Sep::Clique::Ptr &handle_ref = H.get_cliques()[0];
-        for (const Segment &seg : handle_ref->seg_list()) {
-            for (int k = seg.start; k <= seg.end; ++k) {
-                int node = def_tour[k];
-                node_pi_est[node] += pival;
-            }
-        }
+        add_to_segs(clique_bank.seg_list(H.get_cliques()[0]), pival,
+                    domino_est_diff);
+        add_to_teeth(H, pival, domino_est_diff);
+    }
+
+    neg_removed = remove_neg;
+    cut_revision = ext_cuts.cut_revision();
+
+    sum_node_pi(clique_bank.ref_tour());
+}
+
+/**
+ * A single scan over tour positions takes running sums of the difference
+ * arrays, giving the total of each kind of dual on the node at each position.
+ * @param def_tour the reference tour of the CliqueBank.
+ */
+template <typename numtype>
+void DualGroup<numtype>::sum_node_pi(const std::vector<int> &def_tour)
+{
+    node_pi = degree_pi;
+    node_pi_est = degree_pi;
 
-        for (const Sep::Tooth::Ptr &T : H.get_teeth())
-            for (const Sep::Clique &tpart : T->set_pair())
-                for (const Segment &seg : tpart.seg_list())
-                    for (int k = seg.start; k <= seg.end; ++k) {
-                        int node = def_tour[k];
+    numtype clique_sum(0.0);
+    numtype clique_est_sum(0.0);
+    numtype domino_est_sum(0.0);
 
-                        node_pi_est[node] += pival;
-                    }
+    for (int k = 0; k < def_tour.size(); ++k) {
+        int node = def_tour[k];
+
+        clique_sum += clique_diff[k];
+        clique_est_sum += clique_est_diff[k];
+        domino_est_sum += domino_est_diff[k];
+
+        node_pi[node] += clique_sum;
+        node_pi_est[node] += clique_est_sum;
+        node_pi_est[node] += domino_est_sum;
     }
-} catch (const std::exception &e) {
-    std::cerr << e.what() << "\n";
-    throw std::runtime_error("Problem in DualGroup constructor.");
 }
 
+/**
+ * Adds \p val at the start of each Segment and subtracts it one past the end,
+ * so each Segment costs O(1) regardless of its size.
+ * @tparam SegList a range of Segment objects, e.g., Sep::SegRange or a
+ * vector.
+ */
+template <typename numtype>
+template <typename SegList>
+void DualGroup<numtype>::add_to_segs(const SegList &segs, numtype val,
+                                     std::vector<numtype> &pos_diff)
+{
+    for (const Segment &seg : segs) {
+        pos_diff[seg.start] += val;
+        pos_diff[seg.end + 1] -= val;
+    }
+}
+
+template <typename numtype>
+void DualGroup<numtype>::add_to_teeth(const Sep::HyperGraph &H, numtype val,
+                                      std::vector<numtype> &pos_diff)
+{
+    for (const Sep::Tooth::Ptr &T : H.get_teeth())
+        for (const Sep::Clique &tpart : T->set_pair())
+            add_to_segs(tpart.seg_list(), val, pos_diff);
+}
 
 }
 }
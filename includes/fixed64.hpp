@@ -1,71 +1,117 @@
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /** @file
- * @brief Wrapper/arithmetic operators for fixed precision arithmetic.
+ * @brief Header-only fixed precision arithmetic compatible with CCbigguy.
  *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #ifndef CMR_FIXED64_H
 #define CMR_FIXED64_H
 
-extern "C" {
-#include <concorde/INCLUDE/bigguy.h>
-}
-
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+
+#ifndef __SIZEOF_INT128__
+#error "util::Fixed64 requires a compiler with __int128 support"
+#endif
 
 namespace CMR {
 namespace util {
 
-/// A 64-bit fixed precision number type "implemented" as a wrapper to CCbigguy.
-/// @warning Concorde will call abort if any of these computations overflow.
+/// A 64-bit fixed precision number with the layout and rounding of CCbigguy.
+/// Values are stored as a signed count of 2^-32 units, exactly as Concorde's
+/// bigguy with 32 integer and 32 fractional bits. Arithmetic is carried out
+/// in __int128 and checked against the bigguy range.
+/// @warning An overflow_error is thrown if any of these computations would
+/// have made Concorde abort.
 class Fixed64 {
 public:
+    using raw_type = std::int64_t; //!< The scaled underlying integer.
+    __extension__ typedef __int128 wide_type; //!< Overflow-free type.
+
+    static constexpr int FracBits = 32; //!< Number of fractional bits.
+    static constexpr raw_type One = raw_type{1} << FracBits; //!< Raw 1.0.
+
+    /// Largest raw value, CCbigguy_MAXBIGGUY.
+    static constexpr raw_type MaxRaw = INT64_MAX;
+
+    /// Smallest raw value, CCbigguy_MINBIGGUY; the range is symmetric.
+    static constexpr raw_type MinRaw = -INT64_MAX;
+
     Fixed64() = default;
 
     Fixed64(int i) :
-        bg(CCbigguy_itobigguy(i)) {} //!< Construct from integer.
+        raw(static_cast<raw_type>(i) * One) {} //!< Construct from integer.
+
+    Fixed64(double d) : raw(from_double(d)) {} //!< Construct from double.
 
-    Fixed64(double d) :
-        bg(CCbigguy_dtobigguy(d)) {}; //!< Construct from double.
+    /// Construct directly from a raw scaled value.
+    static Fixed64 from_raw(raw_type r)
+        { Fixed64 result; result.raw = r; return result; }
 
+    raw_type raw_val() const { return raw; } //!< The raw scaled value.
 
     double to_d() const
-        { return CCbigguy_bigguytod(bg); } //!< Convert to double.
+        { return static_cast<double>(raw) / One; } //!< Convert to double.
 
+    /// Plus increment.
     Fixed64 &operator+=(Fixed64 f)
-        { CCbigguy_add(&bg, f.bg); return *this; } //!< Plus increment.
+        { raw = checked(wide_type{raw} + f.raw, "+="); return *this; }
 
+    /// Minus decrement.
     Fixed64 &operator-=(Fixed64 f)
-        { CCbigguy_sub(&bg, f.bg); return *this; } //!< Minus decrement.
+        { raw = checked(wide_type{raw} - f.raw, "-="); return *this; }
 
     friend void add_mult(Fixed64 &f, const Fixed64 &g, int m);
 
     /// Integer ceiling.
     Fixed64 ceil() const
-        { Fixed64 result; result.bg = CCbigguy_ceil(bg); return result; }
-
-
-    bool operator<(const Fixed64 &f) const
-        { return CCbigguy_cmp(bg, f.bg) == -1; }
-
-    bool operator==(const Fixed64 &f) const
-        { return CCbigguy_cmp(bg, f.bg) == 0; }
-
-    bool operator!=(const Fixed64 &f) const
-        { return CCbigguy_cmp(bg, f.bg) != 0; }
+        {
+            return from_raw(checked((wide_type{raw} + (One - 1)) &
+                                    ~wide_type{One - 1}, "ceil"));
+        }
 
-    bool operator>(const Fixed64 &f) const
-        { return CCbigguy_cmp(bg, f.bg) == 1; }
 
-    bool operator<=(const Fixed64 &f) const
-        { return CCbigguy_cmp(bg, f.bg) <= 0; }
+    bool operator<(const Fixed64 &f) const { return raw < f.raw; }
+    bool operator==(const Fixed64 &f) const { return raw == f.raw; }
+    bool operator!=(const Fixed64 &f) const { return raw != f.raw; }
+    bool operator>(const Fixed64 &f) const { return raw > f.raw; }
+    bool operator<=(const Fixed64 &f) const { return raw <= f.raw; }
+    bool operator>=(const Fixed64 &f) const { return raw >= f.raw; }
 
-    bool operator>=(const Fixed64 &f) const
-        { return CCbigguy_cmp(bg, f.bg) >= 0; }
+    /// Is \p w within the range of values representable by CCbigguy.
+    static bool in_range(wide_type w) { return w >= MinRaw && w <= MaxRaw; }
 
+    /// Throw an overflow_error from operation \p op.
+    [[noreturn]] static void overflow(const char *op)
+        {
+            throw std::overflow_error(std::string("Fixed64 overflow in ") +
+                                      op);
+        }
 
 private:
-    CCbigguy bg; //!< The underlying Concorde structure.
+    raw_type raw; //!< The value times 2^FracBits.
+
+    /// Narrow \p w back to a raw_type, throwing if it is out of range.
+    static raw_type checked(wide_type w, const char *op)
+        {
+            if (!in_range(w))
+                overflow(op);
+            return static_cast<raw_type>(w);
+        }
+
+    /// Truncate the magnitude of \p d toward zero, like CCbigguy_dtobigguy.
+    static raw_type from_double(double d)
+        {
+            double mag = d < 0.0 ? -d : d;
+            if (!(mag < 2147483648.0)) // also catches NaN
+                overflow("conversion from double");
+
+            raw_type r = static_cast<raw_type>(mag * One);
+            return d < 0.0 ? -r : r;
+        }
 };
 
 inline Fixed64 operator+(Fixed64 a, Fixed64 b) { return a += b; }
@@ -73,7 +119,8 @@ inline Fixed64 operator-(Fixed64 a, Fixed64 b) { return a -= b; }
 
 inline void add_mult(Fixed64 &f, const Fixed64 &g, int m)
 {
-    CCbigguy_addmult(&f.bg, g.bg, m);
+    f.raw = Fixed64::checked(Fixed64::wide_type{f.raw} +
+                             Fixed64::wide_type{g.raw} * m, "add_mult");
 }
 
 inline void add_mult(double &d, const double &g, int m)
@@ -81,6 +128,57 @@ inline void add_mult(double &d, const double &g, int m)
     d += m * g;
 }
 
+/// The sum of the \p n entries starting at \p vals, checked once at the end.
+/// The high and low 32-bit halves are summed separately in 64-bit
+/// accumulators, which cannot overflow for \p n < 2^31, so the loop
+/// vectorizes.
+inline Fixed64 sum(const Fixed64 *vals, std::size_t n)
+{
+    using raw_type = Fixed64::raw_type;
+    using wide_type = Fixed64::wide_type;
+
+    if (n >= (std::size_t{1} << 31)) {
+        Fixed64 half = sum(vals, n / 2);
+        return half + sum(vals + n / 2, n - n / 2);
+    }
+
+    raw_type hi_sum = 0;
+    std::uint64_t lo_sum = 0;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        raw_type r = vals[i].raw_val();
+        hi_sum += r >> 32;
+        lo_sum += static_cast<std::uint32_t>(r);
+    }
+
+    wide_type total = wide_type{hi_sum} * (wide_type{1} << 32) +
+                      wide_type{lo_sum};
+
+    if (!Fixed64::in_range(total))
+        Fixed64::overflow("sum");
+
+    return Fixed64::from_raw(static_cast<raw_type>(total));
+}
+
+/// Add \p m times `src[i]` to `dst[i]` for each of the \p n entries.
+/// Overflow flags are accumulated without branching and checked once after
+/// the loop, as in sum; on overflow the contents of \p dst are unspecified.
+inline void add_mult(Fixed64 *dst, const Fixed64 *src, int m, std::size_t n)
+{
+    using wide_type = Fixed64::wide_type;
+    bool bad = false;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        wide_type w = wide_type{dst[i].raw_val()} +
+                      wide_type{src[i].raw_val()} * m;
+        bad |= !Fixed64::in_range(w);
+        dst[i] = Fixed64::from_raw(static_cast<Fixed64::raw_type>(w));
+    }
+
+    if (bad)
+        Fixed64::overflow("add_mult over arrays");
+}
+
 inline std::ostream &operator<<(std::ostream &os, const Fixed64 &f)
 {
     os << (f.to_d());
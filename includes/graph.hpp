@@ -87,6 +87,11 @@ struct AdjList {
     template <typename EndPt_type>
     AdjList(int ncount, const std::vector<EndPt_type> &elist);
 
+    /// An AdjList for the range `[begin, end)` of an EndPt vector.
+    template <typename EndPt_type>
+    AdjList(int ncount, const std::vector<EndPt_type> &elist,
+            int begin, int end);
+
     /// A support graph type AdjList.
     AdjList(int ncount,
             const std::vector<Edge> &ref_elist,
@@ -175,6 +180,29 @@ AdjList::AdjList(int ncount, const std::vector<EndPt_type> &elist) try
     throw std::runtime_error("AdjList EndPt_type constructor failed.");
 }
 
+/**
+ * @tparam EndPt_type the edge representation being used. Should be derived
+ * from CMR::EndPt.
+ * The AdjObj::edge_index of each edge is its index in \p elist, not its
+ * offset from \p begin.
+ */
+template <typename EndPt_type>
+AdjList::AdjList(int ncount, const std::vector<EndPt_type> &elist,
+                 int begin, int end) try
+    : node_count(ncount), edge_count(end - begin),
+      nodelist(std::vector<Node>(node_count))
+{
+    for (int i = begin; i < end; ++i) {
+        const auto &e = elist[i];
+
+        nodelist[e.end[0]].neighbors.emplace_back(e.end[1], i, 0.0);
+        nodelist[e.end[1]].neighbors.emplace_back(e.end[0], i, 0.0);
+    }
+} catch (const std::exception &e) {
+    std::cerr << e.what() << "\n";
+    throw std::runtime_error("AdjList EndPt_type range constructor failed.");
+}
+
 }
 }
 
@@ -12,11 +12,15 @@
 #include "lp_util.hpp"
 #include "price_util.hpp"
 #include "err_util.hpp"
+#include "datagroups.hpp"
+#include "process_cuts.hpp"
 
 #include <algorithm>
 #include <iostream>
 #include <map>
 #include <stdexcept>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -94,10 +98,18 @@ public:
                     std::vector<int> &rmatind,
                     std::vector<double> &rmatval) const;
 
+    /// Get sparse coefficient rows for a batch of cuts.
+    template <typename EndPt_type>
+    static void get_coeffs(const std::vector<EndPt_type> &edges,
+                           const std::vector<const HyperGraph *> &cuts,
+                           std::vector<LP::SparseRow> &rows,
+                           std::vector<int> &end_pos);
+
     char get_sense() const { return sense; }
     double get_rhs() const { return rhs; }
 
-    const std::vector<Clique::Ptr> &get_cliques() const { return cliques; }
+    /// The cliques of the cut, as ids in the CliqueBank it was built from.
+    const std::vector<CliqueId> &get_cliques() const { return cliques; }
     const std::vector<Tooth::Ptr> &get_teeth() const { return teeth; }
 
     friend class ExternalCuts;
@@ -106,9 +118,20 @@ private:
     char sense; //!< The inequality sense of the cut.
     double rhs; //!< The righthand-side of the cut.
 
-    std::vector<Clique::Ptr> cliques; //!< The cliques comprising the cut.
+    std::vector<CliqueId> cliques; //!< The cliques comprising the cut.
     std::vector<Tooth::Ptr> teeth; //!< The teeth comprising the cut.
 
+    /// Coefficient row for edges given by the tour positions of their ends.
+    void pos_coeffs(const std::vector<int> &end_pos,
+                    std::vector<int> &rmatind,
+                    std::vector<double> &rmatval) const;
+
+    /// Map edge endpoints to their positions in the tour of \p perm.
+    template <typename EndPt_type>
+    static void tour_positions(const std::vector<EndPt_type> &edges,
+                               const std::vector<int> &perm,
+                               std::vector<int> &end_pos);
+
     CliqueBank *source_bank; //!< The CliqueBank for dereferencing the cliques.
     ToothBank *source_toothbank; //!< The ToothBank for the teeth.
 
@@ -130,6 +153,28 @@ inline std::ostream &operator<<(std::ostream &os, HyperGraph::Type t)
     return os;
 }
 
+/// A flat copy of the cuts in an ExternalCuts, as stored in a checkpoint.
+/// Cliques are lists of segments of positions in ref_tour. The first lp_count
+/// cuts are rows of the LP and the rest are cuts from the pool.
+struct CutImage {
+    std::vector<int> ref_tour; //!< The tour indexed by the segments.
+
+    std::vector<int> clique_beg; //!< Offsets of each clique into segs.
+    std::vector<int> segs; //!< Segments as start/end position pairs.
+    std::vector<char> clique_sorted; //!< Are a clique's segments in order.
+
+    std::vector<int> cut_beg; //!< Offsets of each cut into clique_refs.
+    std::vector<int> clique_refs; //!< Indices of the cliques of each cut.
+    std::vector<int> tooth_beg; //!< Offsets of each cut into tooth_refs.
+    std::vector<int> tooth_refs; //!< Root/body clique index pairs of teeth.
+
+    std::vector<char> sense; //!< Sense of each cut.
+    std::vector<double> rhs; //!< Righthand side of each cut.
+    std::vector<int> ages; //!< Tour/pivot age pairs of the LP cuts.
+
+    int lp_count = 0; //!< The number of cuts in the LP.
+};
+
 /// The external storage of a collection of HyperGraph cuts in a Relaxation.
 class ExternalCuts {
 public:
@@ -158,6 +203,18 @@ public:
 
     void pool_add(const HyperGraph &H); //!< Add a cut to the pool.
 
+    /// Write the pool and the clique cuts of the LP to a binary pool file.
+    void save_pool(const std::string &fname) const;
+
+    /// Add the cuts in the binary pool file \p fname to the pool.
+    int load_pool(const std::string &fname);
+
+    /// A flat copy of the LP cuts and the pool, for checkpointing.
+    CutImage get_image() const;
+
+    /// Add the pool cuts of \p img to the pool and queue its LP cuts.
+    void load_image(const CutImage &img, CutQueue<HyperGraph> &lp_q);
+
     void reset_ages(); //!< Reset the ages of all cuts to zero.
     void tour_age_cuts(std::vector<double> duals); //!< Update tour ages.
     void piv_age_cuts(std::vector<double> duals); //!< Update pivot ages.
@@ -174,6 +231,9 @@ public:
 
     int cut_count() const { return cuts.size(); }
 
+    /// Incremented whenever a cut is added or deleted.
+    int cut_revision() const { return revision; }
+
     int pool_count() const { return cc_pool ? cc_pool->cutcount : 0; }
 
     const CliqueBank &get_cbank() const { return clique_bank; }
@@ -183,6 +243,26 @@ public:
     void get_col(int end0, int end1, std::vector<int> &cmatind,
                  std::vector<double> &cmatval) const;
 
+    /// Get the columns associated with a batch of edges to be added to the lp.
+    void get_cols(const std::vector<Graph::Edge> &batch,
+                  std::vector<int> &cmatbeg, std::vector<int> &cmatind,
+                  std::vector<double> &cmatval) const;
+
+    /// Index the cliques of all cuts against the edges of \p core_graph.
+    void index_core_edges(const Graph::CoreGraph &core_graph);
+
+    /// Update the clique edge index after edges are appended to the core.
+    void core_edges_added(int old_ecount);
+
+    /// Update the clique edge index after edges are removed from the core.
+    void core_edges_removed(const std::vector<int> &edge_delstat);
+
+    /// Core edge indices with exactly one end in the Clique \p id, or nullptr.
+    const std::vector<int> *clique_edges(CliqueId id) const;
+
+    /// The number of core edges known to the clique edge index.
+    int indexed_edge_count() const { return indexed_ecount; }
+
     friend class Separator;
 
 private:
@@ -197,16 +277,52 @@ private:
 
     std::vector<HyperGraph> cuts; //!< List of the cuts in the CoreLP.
 
+    int revision; //!< Count of changes to the list of cuts.
+
     std::vector<HyperGraph> cut_pool; //!< Pool of cuts pruned from CoreLP.
 
     CCtsp_lpcuts *cc_pool; //!< Concorde rep of cut pool.
 
     CCtsp_cuttree tightcuts; //!< Cut tree for separation routines.
 
+    void index_cut(const HyperGraph &H); //!< Index new cliques of \p H.
+    void index_clique(CliqueId id); //!< Compute the edges cut by \p id.
+
+    /// The core graph for the clique edge index, or nullptr if not indexed.
+    const Graph::CoreGraph *index_graph;
+
+    int indexed_ecount; //!< Number of core edges in the clique edge index.
+
+    /// For each Clique of a non-domino cut, the core edges it cuts.
+    std::unordered_map<CliqueId, std::vector<int>> clique_edge_index;
+
+    std::vector<int> index_marks; //!< Node marks for index_clique.
+    int index_marker; //!< Current value of the marks in index_marks.
 };
 
 //////////////////// TEMPLATE METHOD IMPLEMENTATIONS //////////////////////////
 
+/**
+ * @tparam EndPt_type a structure derived from EndPts that stores an edge `e`
+ * as a length-two array accessed as `e.end[0]` and `e.end[1]`
+ * @param[in] edges the list of edges for which to generate coefficients.
+ * @param[in] perm the permutation vector of the reference tour.
+ * @param[out] end_pos `end_pos[2 * i + k]` is the tour position of
+ * `edges[i].end[k]`. Existing capacity is reused.
+ */
+template <typename EndPt_type>
+void HyperGraph::tour_positions(const std::vector<EndPt_type> &edges,
+                                const std::vector<int> &perm,
+                                std::vector<int> &end_pos)
+{
+    end_pos.resize(2 * edges.size());
+
+    for (int i = 0; i < edges.size(); ++i) {
+        end_pos[2 * i] = perm[edges[i].end[0]];
+        end_pos[2 * i + 1] = perm[edges[i].end[1]];
+    }
+}
+
 /**
  * @tparam EndPt_type a structure derived from EndPts that stores an edge `e`
  * as a length-two array accessed as `e.end[0]` and `e.end[1]`
@@ -220,134 +336,52 @@ void HyperGraph::get_coeffs(const std::vector<EndPt_type> &edges,
                             std::vector<int> &rmatind,
                             std::vector<double> &rmatval) const
 {
-    using std::vector;
-
     if (cut_type() == Type::Non)
         throw std::runtime_error("Tried HyperGraph::get_coeffs on Non cut.");
 
-    rmatind.clear();
-    rmatval.clear();
-
-    const vector<int> &def_tour = source_bank->ref_tour();
-    int ncount = def_tour.size();
-
-    std::map<int, int> coeff_map;
-    vector<bool> node_marks(ncount, false);
-
-    if (cut_type() != Type::Domino) {
-        for (const Clique::Ptr &clq_ref : cliques) {
-            for (const Segment &seg : clq_ref->seg_list())
-                for (int k = seg.start; k <= seg.end; ++k)
-                    node_marks[def_tour[k]] = true;
-
-            for (int i = 0; i < edges.size(); ++i) {
-                if (node_marks[edges[i].end[0]] !=
-                    node_marks[edges[i].end[1]]) {
-                    if (coeff_map.count(i))
-                        coeff_map[i] += 1;
-                    else
-                        coeff_map[i] = 1;
-                }
-            }
-
-            node_marks = vector<bool>(ncount, false);
-        }
+    std::vector<int> end_pos;
 
-        rmatind.reserve(coeff_map.size());
-        rmatval.reserve(coeff_map.size());
+    tour_positions(edges, source_bank->ref_perm(), end_pos);
+    pos_coeffs(end_pos, rmatind, rmatval);
+}
 
-        for (std::pair<const int, int> &kv : coeff_map) {
-            rmatind.push_back(kv.first);
-            rmatval.push_back(kv.second);
-        }
+/**
+ * The endpoints of \p edges are mapped to tour positions once, and then the
+ * row of each cut is computed from the positions.
+ * @tparam EndPt_type a structure derived from EndPts that stores an edge `e`
+ * as a length-two array accessed as `e.end[0]` and `e.end[1]`
+ * @param[in] edges the list of edges for which to generate coefficients.
+ * @param[in] cuts the cuts for which to compute rows. These must share a
+ * reference tour.
+ * @param[out] rows `rows[i]` gets the coefficients, sense, and rhs of
+ * `*cuts[i]`. Existing capacity of the rows is reused.
+ * @param end_pos scratch space for endpoint tour positions, which may be
+ * reused across calls.
+ */
+template <typename EndPt_type>
+void HyperGraph::get_coeffs(const std::vector<EndPt_type> &edges,
+                            const std::vector<const HyperGraph *> &cuts,
+                            std::vector<LP::SparseRow> &rows,
+                            std::vector<int> &end_pos)
+{
+    rows.resize(cuts.size());
 
+    if (cuts.empty())
         return;
-    } //else it is a domino cut
-
-    const Clique::Ptr &handle_ref = cliques[0];
-    for (const Segment &seg : handle_ref->seg_list())
-        for (int k = seg.start; k <= seg.end; ++k)
-            node_marks[def_tour[k]] = true;
-
-    for (int i = 0; i < edges.size(); ++i) {
-        bool e0 = node_marks[edges[i].end[0]];
-        bool e1 = node_marks[edges[i].end[1]];
-
-        if (e0 && e1) {
-            if (coeff_map.count(i))
-                coeff_map[i] += 2;
-            else
-                coeff_map[i] = 2;
-        } else if (e0 != e1) {
-            if (coeff_map.count(i))
-                coeff_map[i] += 1;
-            else
-                coeff_map[i] = 1;
-        }
-    }
-
-    node_marks = vector<bool>(ncount, false);
-
-    const vector<int> &tooth_perm = source_toothbank->ref_perm();
-
-    for (const Tooth::Ptr &t_ref : teeth) {
-        const Clique &root_clq = t_ref->set_pair()[0];
-        const Clique &bod_clq = t_ref->set_pair()[1];
-
-        for (const Segment &seg : bod_clq.seg_list())
-            for (int k = seg.start; k <= seg.end; ++k)
-                node_marks[def_tour[k]] = true;
-
-        for (int i = 0; i < edges.size(); ++i) {
-            int e0 = edges[i].end[0];
-            int e1 = edges[i].end[1];
-
-            bool bod_e0 = node_marks[e0];
-            bool bod_e1 = node_marks[e1];
-
-            if (bod_e0 && bod_e1) {
-                if (coeff_map.count(i))
-                    coeff_map[i] += 2;
-                else
-                    coeff_map[i] = 2;
-            } else if (bod_e0 != bod_e1) {
-                if (bod_e0) {
-                    if (root_clq.contains(tooth_perm[e1])) {
-                        if (coeff_map.count(i))
-                            coeff_map[i] += 1;
-                        else coeff_map[i] = 1;
-                    }
-                } else { //bod_e1
-                    if (root_clq.contains(tooth_perm[e0])) {
-                        if (coeff_map.count(i))
-                            coeff_map[i] += 1;
-                        else coeff_map[i] = 1;
-                    }
-                }
-            }
-        }
-
-        std::fill(node_marks.begin(), node_marks.end(), false);
-    }
 
-    int coeff_size = 0;
+    for (const HyperGraph *H : cuts)
+        if (H->cut_type() == Type::Non)
+            throw std::runtime_error("Tried HyperGraph::get_coeffs on Non cut.");
 
-    for (std::pair<const int, int> &kv : coeff_map)
-        if (kv.second % 2 == 0)
-            ++coeff_size;
+    tour_positions(edges, cuts.front()->source_bank->ref_perm(), end_pos);
 
-    rmatind.reserve(coeff_size);
-    rmatval.reserve(coeff_size);
+    for (int i = 0; i < cuts.size(); ++i) {
+        const HyperGraph &H = *cuts[i];
+        LP::SparseRow &R = rows[i];
 
-    for (std::pair<const int, int> &kv : coeff_map) {
-        int ind = kv.first;
-        double coeff = kv.second;
-        coeff /= 2;
-        coeff = floor(coeff);
-        if (fabs(coeff) >= Epsilon::Zero) {
-            rmatind.push_back(ind);
-            rmatval.push_back(coeff);
-        }
+        R.sense = H.sense;
+        R.rhs = H.rhs;
+        H.pos_coeffs(end_pos, R.rmatind, R.rmatval);
     }
 }
 
@@ -46,6 +46,9 @@ public:
 
     ~Relaxation(); //!< Destruct and free resource handles.
 
+    /// Copy the problem data into a Relaxation with its own environment.
+    Relaxation clone() const;
+
     ///@}
 
     /**@name Methods for querying the relaxation. */
@@ -97,6 +100,8 @@ public:
 
     SolStat get_stat() const; //!< Get the SolStat from last optimization.
 
+    int opt_method() const; //!< The method used in the last optimization.
+
     double condition_num() const; //!< Condition number for resident solution.
 
     void get_x(std::vector<double> &x) const; //!< Get current solution.
@@ -176,6 +181,8 @@ public:
                   const std::vector<int> &rmatind,
                   const std::vector<double> &rmatval); //!< Add constraint rows.
 
+    void add_cuts(const RowBatch &batch); //!< Add a block of rows.
+
     /// Delete a not-necessarily-contiguous set of rows.
     void del_set_rows(std::vector<int> &delstat);
 
@@ -184,6 +191,13 @@ public:
                  const std::vector<double> &coeffs,
                  const double lb, const double ub); //!< Add a column.
 
+    void add_cols(const std::vector<double> &objval,
+                  const std::vector<int> &cmatbeg,
+                  const std::vector<int> &cmatind,
+                  const std::vector<double> &cmatval,
+                  const std::vector<double> &lb,
+                  const std::vector<double> &ub); //!< Add columns.
+
     /// Delete a not-necessarily-contiguous set of columns.
     void del_set_cols(std::vector<int> &delstat);
 
@@ -218,6 +232,12 @@ public:
 
     void primal_opt(); //!< Optimize the Relaxation with primal simplex.
     void dual_opt(); //!< Optimize the relaxation with dual simplex.
+
+    /// Optimize the Relaxation from scratch or after large changes.
+    void full_opt();
+
+    /// Set the ThreadPolicy used by full_opt.
+    void set_thread_policy(const ThreadPolicy &policy);
     void nondegen_pivot(double upper_bound); //!< Primal non-degenerate pivot.
 
     void one_primal_pivot(); //!< Perform exactly one primal simplex pivot.
@@ -230,6 +250,14 @@ public:
     void init_mir_data(Sep::MIRgroup &mir_data); //!< Construct a Sep::MirGroup.
 
 private:
+    /// Strong branch estimates and contra basis for a single candidate.
+    void sb_candidate(const std::vector<double> &tour_vec,
+                      const std::vector<int> &colstat,
+                      const std::vector<int> &rowstat,
+                      int ind, Estimate &down, Estimate &up,
+                      Basis &contra_base, bool have_base,
+                      int itlim, double upperbound);
+
     struct solver_impl; //!< Implementation hiding for solver.
     std::unique_ptr<solver_impl> simpl_p; //!< Pointer to solver implementation.
 };
@@ -72,6 +72,26 @@ enum BStat {
     FreeSuper = 3 //!< Free variable.
 };
 
+/// How the LP solver may use threads in long reoptimizations.
+/// Only Relaxation::full_opt uses this policy. With more than one thread it
+/// optimizes with the barrier method or concurrently, since simplex pivoting
+/// cannot use more threads. Single pivots, strong branching, and short
+/// optimizations always run on one thread in deterministic mode, so that
+/// pivoting is reproducible.
+struct ThreadPolicy {
+    /// Parallel modes for long reoptimizations with more than one thread.
+    enum class Mode {
+        Deterministic, //!< Barrier, reproducible for a fixed thread count.
+        Opportunistic, //!< Barrier, faster but not reproducible.
+        Concurrent, //!< Race primal, dual, and barrier, opportunistically.
+    };
+
+    /// Thread limit, or 0 to let the solver choose. With one thread, full_opt
+    /// uses primal simplex and the mode is ignored.
+    int threads = 1;
+    Mode mode = Mode::Deterministic; //!< The parallel mode.
+};
+
 /// Row and column basic statuses corresponding to some LP solution.
 struct Basis {
     Basis() = default;
@@ -94,6 +114,55 @@ struct Basis {
     using Ptr = std::unique_ptr<Basis>;
 };
 
+/// The statuses of a Basis packed at two bits each.
+class PackedBasis {
+public:
+    PackedBasis() = default;
+
+    explicit PackedBasis(const Basis &base); //!< Pack \p base.
+
+    int col_count() const { return ccount; }
+    int row_count() const { return rcount; }
+
+    /// The status of column \p i, or of row `i - col_count()` past it.
+    int stat(int i) const { return (bits[i / 4] >> (2 * (i % 4))) & 3; }
+
+    Basis unpack() const; //!< The Basis that was packed.
+
+    using Ptr = std::shared_ptr<const PackedBasis>;
+
+private:
+    int ccount = 0;
+    int rcount = 0;
+    std::vector<unsigned char> bits; //!< Column then row statuses.
+};
+
+/// A Basis stored as its differences from a shared reference PackedBasis.
+/// This is meant for bases that are a few pivots away from a common starting
+/// basis, like those found by strong branching, so that the memory used by
+/// each is proportional to the number of statuses that changed.
+class BasisDelta {
+public:
+    BasisDelta() = default; //!< Construct an empty delta.
+
+    /// Store \p base as its differences from \p ref.
+    /// If \p ref is null or of different dimensions, \p base is packed as
+    /// its own reference.
+    BasisDelta(const Basis &base, PackedBasis::Ptr ref);
+
+    bool empty() const { return ref == nullptr; }
+    void clear(); //!< Release the delta and its share of the reference.
+
+    Basis unpack() const; //!< Decode the stored Basis.
+
+private:
+    PackedBasis::Ptr ref; //!< The reference basis.
+
+    /// Entries `(i << 2) | stat` for statuses differing from ref, indexed as
+    /// in PackedBasis::stat.
+    std::vector<unsigned> diffs;
+};
+
 /// Struct for storing info from branching estimates.
 struct Estimate {
     Estimate() = default;
@@ -154,6 +223,36 @@ struct SparseRow {
     double lp_viol = 0.0; //!< (Optional) violation wrt some vector.
 };
 
+/// A block of rows in the compressed form taken by Relaxation::add_cuts.
+/// The buffers keep their capacity through clear(), so one RowBatch can be
+/// reused for every round of cuts.
+struct RowBatch {
+    void clear()
+        {
+            rhs.clear(); sense.clear(); rmatbeg.clear();
+            rmatind.clear(); rmatval.clear();
+        }
+
+    /// Append the row \p R to the block.
+    void push_back(const SparseRow &R)
+        {
+            rhs.push_back(R.rhs);
+            sense.push_back(R.sense);
+            rmatbeg.push_back(rmatind.size());
+            rmatind.insert(rmatind.end(), R.rmatind.begin(), R.rmatind.end());
+            rmatval.insert(rmatval.end(), R.rmatval.begin(), R.rmatval.end());
+        }
+
+    int size() const { return rmatbeg.size(); } //!< Number of rows.
+    bool empty() const { return rmatbeg.empty(); }
+
+    std::vector<double> rhs;
+    std::vector<char> sense;
+    std::vector<int> rmatbeg; //!< Start of each row in rmatind/rmatval.
+    std::vector<int> rmatind;
+    std::vector<double> rmatval;
+};
+
 inline std::ostream &operator<<(std::ostream &os, PivType piv)
 {
     using Ptype = LP::PivType;
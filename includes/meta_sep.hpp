@@ -28,6 +28,13 @@ public:
              const LP::ActiveTour &active_tour_,
              Data::SupportGroup &s_dat);
 
+    /// Construct a MetaCuts separator using a shared TourGraph cache.
+    MetaCuts(const ExternalCuts &EC_,
+             const std::vector<Graph::Edge> &core_edges_,
+             const LP::ActiveTour &active_tour_,
+             Data::SupportGroup &s_dat,
+             TourGraphCache &tg_cache);
+
     /// Categories of implemented cut metamorphoses.
     enum class Type {
         Decker,
@@ -57,7 +64,7 @@ private:
 
     bool pure_comb(CCtsp_lpcut_in &c); //!< Is \p c a pure comb.
 
-    std::unordered_map<Clique, double> clique_vals;
+    std::vector<double> clique_vals; //!< LP values of Cliques, indexed by id.
 
     using HGitr = std::vector<HyperGraph>::const_iterator;
     std::vector<HGitr> interest_combs;
@@ -68,7 +75,8 @@ private:
     const LP::ActiveTour &active_tour;
     Data::SupportGroup &supp_data;
 
-    TourGraph TG;
+    TourGraph own_TG; //!< TourGraph used if there is no cache.
+    TourGraph &TG;
     std::vector<int> perm_elist;
 
     LPcutList meta_q;
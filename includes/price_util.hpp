@@ -25,6 +25,15 @@ constexpr int ScaleBatch = 3; //!< Scale factor for EstBatch.
 
 constexpr int f64Batch = 5000000; //!< Max number to generate during exact lb.
 
+/// Default number of node pairs priced per block in a full graph exact lb.
+constexpr int FullLbBatch = 1000000;
+
+/// Min number of edges given to each thread when pricing in parallel.
+constexpr int MinPriceBlock = 20000;
+
+/// Number of edge lengths computed at a time when pricing.
+constexpr int LenChunk = 512;
+
 constexpr double MaxPenalty = 0.10;
 
 constexpr double RecoverMaxPen = 0.00000001;
@@ -16,13 +16,21 @@
 #include "err_util.hpp"
 #include "fixed64.hpp"
 #include "edgehash.hpp"
+#include "config.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <iostream>
 #include <memory>
 #include <queue>
 #include <stdexcept>
 #include <unordered_map>
 #include <vector>
 
+#if CMR_USE_OMP
+#include <omp.h>
+#endif
+
 namespace CMR {
 
 /// Matters related to pricing sets of edges.
@@ -59,9 +67,44 @@ public:
 
     int verbose = 0;
 
+    /// Max number of node pairs held in memory by a full graph exact_lb.
+    int full_lb_batch = FullLbBatch;
+
 private:
     std::vector<Graph::Edge> pool_chunk(std::vector<PrEdge<double>> &edge_q);
 
+    /// Construct \p duals if null, else update it for the current LP.
+    template <typename numtype>
+    void refresh_duals(std::unique_ptr<LP::DualGroup<numtype>> &duals,
+                       bool remove_neg);
+
+    /// Stream the complete graph in blocks, summing negative reduced costs.
+    util::Fixed64 full_rc_sum(std::vector<PrEdge<util::Fixed64>> &neg_edges);
+
+    /// Price lengths and node duals for a contiguous block of edges.
+    template <typename numtype>
+    void price_node_pi(std::vector<PrEdge<numtype>> &target_edges,
+                       int begin, int end,
+                       const std::vector<numtype> &node_pi,
+                       bool include_len) const;
+
+    /// Price the cliques and dominos for a contiguous block of edges.
+    template <typename numtype>
+    void price_block(std::vector<PrEdge<numtype>> &target_edges,
+                     int begin, int end,
+                     const LP::DualGroup<numtype> &duals) const;
+
+    /// Price the domino cuts for a contiguous block of edges.
+    template <typename numtype>
+    void price_dominos(std::vector<PrEdge<numtype>> &target_edges,
+                       int begin, int end,
+                       const LP::DualGroup<numtype> &duals) const;
+
+    /// Price the core edges using the ExternalCuts clique edge index.
+    template <typename numtype>
+    void price_core_edges(std::vector<PrEdge<numtype>> &core_edges,
+                          std::unique_ptr<LP::DualGroup<numtype>> &duals);
+
     bool scan_adjlist(std::vector<PrEdge<util::Fixed64>> &gen_edges,
                       int &node_index);
 
@@ -98,6 +141,22 @@ private:
 
 //////////////////// TEMPLATE METHOD IMPLEMENTATIONS //////////////////////////
 
+/**
+ * The DualGroups kept by a Pricer persist between pricing calls, so that
+ * when only some cut duals have changed DualGroup::update can apply the
+ * difference instead of rebuilding the clique and node values.
+ */
+template <typename numtype>
+void Pricer::refresh_duals(std::unique_ptr<LP::DualGroup<numtype>> &duals,
+                           bool remove_neg)
+{
+    if (duals)
+        duals->update(remove_neg, core_lp, ext_cuts);
+    else
+        duals = util::make_unique<LP::DualGroup<numtype>>(remove_neg, core_lp,
+                                                          ext_cuts);
+}
+
 /**
  * @tparam numtype the number type for computing reduced costs. Should be
  * double or util::fixed64.
@@ -106,6 +165,11 @@ private:
  * @param include_len true iff the length of an edge will be included in its
  * price. Should always be true except when pricing edges to recover an
  * infeasible LP.
+ * @remark If CMR_USE_OMP is defined, \p target_edges is split into one
+ * contiguous block per thread, and each thread computes the length, node,
+ * clique and domino parts of the reduced costs in its block with its own
+ * adjacency list and node marks. Blocks are disjoint so no combination step
+ * is needed.
  */
 template <typename numtype>
 void Pricer::price_edges(std::vector<PrEdge<numtype>> &target_edges,
@@ -125,59 +189,166 @@ void Pricer::price_edges(std::vector<PrEdge<numtype>> &target_edges,
                                             core_lp.external_cuts());
         } CMR_CATCH_PRINT_THROW("getting duals", err);
 
-    vector<numtype> &node_pi = duals->node_pi;
-    vector<numtype> &cut_pi = duals->cut_pi;
-    std::unordered_map<Sep::Clique, numtype> &clique_pi = duals->clique_pi;
-
-    if (include_len) {
-        for (auto &e : target_edges)
-            e.redcost = inst.edgelen(e.end[0], e.end[1]) - node_pi[e.end[0]]
-            - node_pi[e.end[1]];
-    } else {
-        for (auto &e : target_edges)
-            e.redcost = 0 - node_pi[e.end[0]] - node_pi[e.end[1]];
+    for (const Sep::HyperGraph &H : ext_cuts.get_cuts())
+        if (H.cut_type() == CutType::Non)
+            throw std::runtime_error("Called pricing w Non HyperGraph present.");
+
+    const vector<numtype> &node_pi = duals->node_pi;
+    int ecount = target_edges.size();
+
+#if !(CMR_USE_OMP)
+    try {
+        price_node_pi(target_edges, 0, ecount, node_pi, include_len);
+    } CMR_CATCH_PRINT_THROW("pricing node duals", err);
+
+    try {
+        price_block(target_edges, 0, ecount, *duals);
+    } CMR_CATCH_PRINT_THROW("pricing edge block", err);
+#else
+    int blockcount = std::min(omp_get_max_threads(), ecount / MinPriceBlock);
+    if (blockcount < 1)
+        blockcount = 1;
+
+    int blocksize = (ecount + blockcount - 1) / blockcount;
+    std::atomic<bool> caught_exception(false);
+
+    #pragma omp parallel for
+    for (int b = 0; b < blockcount; ++b) {
+        if (caught_exception)
+            continue;
+
+        int begin = b * blocksize;
+        int end = std::min(begin + blocksize, ecount);
+
+        try {
+            price_node_pi(target_edges, begin, end, node_pi, include_len);
+            price_block(target_edges, begin, end, *duals);
+        } catch (const std::exception &e) {
+            #pragma omp critical
+            {
+                std::cerr << e.what() << " pricing block " << b << "\n";
+                caught_exception = true;
+            }
+        }
+    }
+
+    if (caught_exception)
+        throw err;
+#endif
+}
+
+/**
+ * Sets the reduced cost of each edge in `target_edges[begin], ...,
+ * target_edges[end - 1]` to its length minus the \p node_pi values of its
+ * ends. Lengths are computed #LenChunk edges at a time by
+ * Data::Instance::edgelens, so that the norm is dispatched once per chunk.
+ * @param include_len if false, lengths are taken to be zero.
+ */
+template <typename numtype>
+void Pricer::price_node_pi(std::vector<PrEdge<numtype>> &target_edges,
+                           int begin, int end,
+                           const std::vector<numtype> &node_pi,
+                           bool include_len) const
+{
+    double lens[LenChunk];
+
+    for (int first = begin; first < end; first += LenChunk) {
+        int count = std::min(LenChunk, end - first);
+        PrEdge<numtype> *chunk = &target_edges[first];
+
+        if (include_len)
+            inst.edgelens(chunk, count, lens);
+        else
+            std::fill(lens, lens + count, 0.0);
+
+        for (int k = 0; k < count; ++k) {
+            PrEdge<numtype> &e = chunk[k];
+            e.redcost = lens[k] - node_pi[e.end[0]] - node_pi[e.end[1]];
+        }
     }
+}
+
+/**
+ * Subtracts the clique and domino dual contributions from the reduced costs
+ * of `target_edges[begin], ..., target_edges[end - 1]`, whose node pi part
+ * must already be set. Only the entries in the range are modified, using
+ * an adjacency list and marks local to this call, so disjoint ranges may be
+ * priced concurrently.
+ */
+template <typename numtype>
+void Pricer::price_block(std::vector<PrEdge<numtype>> &target_edges,
+                         int begin, int end,
+                         const LP::DualGroup<numtype> &duals) const
+{
+    using std::vector;
+
+    std::runtime_error err("Problem in Pricer::price_block.");
+
+    if (begin >= end)
+        return;
+
+    const std::unordered_map<Sep::CliqueId, numtype> &clique_pi =
+    duals.clique_pi;
 
     Graph::AdjList price_adjlist;
 
     try  {
-        price_adjlist = Graph::AdjList(inst.node_count(), target_edges);
+        price_adjlist = Graph::AdjList(inst.node_count(), target_edges,
+                                       begin, end);
     } CMR_CATCH_PRINT_THROW("Couldn't build price adjlist.", err);
 
     vector<Graph::Node> &price_nodelist = price_adjlist.nodelist;
 
-    const std::vector<int> &def_tour = ext_cuts.get_cbank().ref_tour();
+    const Sep::CliqueBank &clique_bank = ext_cuts.get_cbank();
+    const std::vector<int> &def_tour = clique_bank.ref_tour();
     int marker = 0;
 
-    for (const std::pair<Sep::Clique, numtype> &kv : clique_pi) {
-        const Sep::Clique &clq = kv.first;
+    for (const std::pair<const Sep::CliqueId, numtype> &kv : clique_pi) {
         numtype pival = kv.second;
 
         if (pival != 0.0) {
             numtype add_back = pival + pival;
             ++marker;
 
-            for (int j : clq.node_list(def_tour)) {
-                for (Graph::AdjObj &nbr : price_nodelist[j].neighbors)
-                    if (price_nodelist[nbr.other_end].mark == marker)
-                        target_edges[nbr.edge_index].redcost += add_back;
+            for (const Segment &seg : clique_bank.seg_list(kv.first))
+                for (int k = seg.start; k <= seg.end; ++k) {
+                    int j = def_tour[k];
 
-                price_nodelist[j].mark = marker;
-            }
+                    for (Graph::AdjObj &nbr : price_nodelist[j].neighbors)
+                        if (price_nodelist[nbr.other_end].mark == marker)
+                            target_edges[nbr.edge_index].redcost += add_back;
+
+                    price_nodelist[j].mark = marker;
+                }
         }
     }
 
+    try {
+        price_dominos(target_edges, begin, end, duals);
+    } CMR_CATCH_PRINT_THROW("pricing domino cuts", err);
+}
+
+/**
+ * Subtracts the domino parity dual contributions from the reduced costs of
+ * `target_edges[begin], ..., target_edges[end - 1]`.
+ */
+template <typename numtype>
+void Pricer::price_dominos(std::vector<PrEdge<numtype>> &target_edges,
+                           int begin, int end,
+                           const LP::DualGroup<numtype> &duals) const
+{
+    using std::vector;
+    using CutType = Sep::HyperGraph::Type;
+
+    std::runtime_error err("Problem in Pricer::price_dominos.");
+
+    const vector<numtype> &cut_pi = duals.cut_pi;
     const vector<Sep::HyperGraph> &cutlist = ext_cuts.get_cuts();
-    vector<int> rmatind;
-    vector<double> rmatval;
 
     for (int i = 0; i < cutlist.size(); ++i) {
         numtype pival = cut_pi[i];
         const Sep::HyperGraph &H = cutlist[i];
 
-        if (H.cut_type() == CutType::Non)
-            throw std::runtime_error("Called pricing w Non HyperGraph present.");
-
         if (H.cut_type() != CutType::Domino)
             continue;
 
@@ -185,13 +356,92 @@ void Pricer::price_edges(std::vector<PrEdge<numtype>> &target_edges,
             continue;
 
         try {
-            H.get_coeffs(target_edges, rmatind, rmatval);
+            for (int j = begin; j < end; ++j) {
+                PrEdge<numtype> &e = target_edges[j];
+                double coeff = H.get_coeff(e.end[0], e.end[1]);
+
+                if (coeff != 0.0)
+                    util::add_mult(e.redcost, pival, -coeff);
+            }
         } CMR_CATCH_PRINT_THROW("geting domino price edge coeffs", err);
+    }
+}
 
-        for (int j = 0; j < rmatind.size(); ++j)
-            util::add_mult(target_edges[rmatind[j]].redcost,
-                           pival, -rmatval[j]);
+/**
+ * Computes the same reduced costs as price_edges, but for the core edges
+ * only, without building an adjacency list. Edges are first priced with
+ * the degree duals alone, and then each Clique dual is subtracted from the
+ * edges it cuts as recorded by Sep::ExternalCuts::clique_edges, making the
+ * clique part a sparse matrix-vector product. If the index is out of sync
+ * with the core graph, this falls back to price_edges.
+ * @param[out] core_edges the edges of the core graph with their reduced
+ * costs, indexed as in the core graph.
+ * @param duals the dual solution info, computed here if null.
+ */
+template <typename numtype>
+void Pricer::price_core_edges(std::vector<PrEdge<numtype>> &core_edges,
+                              std::unique_ptr<LP::DualGroup<numtype>> &duals)
+{
+    using std::vector;
+    using Dual = LP::DualGroup<numtype>;
+    using CutType = Sep::HyperGraph::Type;
+
+    std::runtime_error err("Problem in Pricer::price_core_edges.");
+
+    const vector<Graph::Edge> &edges = core_graph.get_edges();
+    int ecount = edges.size();
+
+    try {
+        core_edges.clear();
+        core_edges.reserve(ecount);
+        for (const Graph::Edge &e : edges)
+            core_edges.emplace_back(e.end[0], e.end[1]);
+    } CMR_CATCH_PRINT_THROW("building core target edges", err);
+
+    if (!duals)
+        try {
+            duals = util::make_unique<Dual>(false, core_lp,
+                                            core_lp.external_cuts());
+        } CMR_CATCH_PRINT_THROW("getting duals", err);
+
+    const std::unordered_map<Sep::CliqueId, numtype> &clique_pi =
+    duals->clique_pi;
+
+    bool indexed = (ext_cuts.indexed_edge_count() == ecount);
+
+    if (indexed)
+        for (const std::pair<const Sep::CliqueId, numtype> &kv : clique_pi)
+            if (kv.second != 0.0 && ext_cuts.clique_edges(kv.first) == nullptr)
+                indexed = false;
+
+    if (!indexed) {
+        try { price_edges(core_edges, duals, true); }
+        CMR_CATCH_PRINT_THROW("pricing unindexed core edges", err);
+        return;
     }
+
+    for (const Sep::HyperGraph &H : ext_cuts.get_cuts())
+        if (H.cut_type() == CutType::Non)
+            throw std::runtime_error("Called pricing w Non HyperGraph present.");
+
+    const vector<numtype> &node_pi = duals->degree_pi;
+
+    try {
+        price_node_pi(core_edges, 0, ecount, node_pi, true);
+    } CMR_CATCH_PRINT_THROW("pricing degree duals", err);
+
+    for (const std::pair<const Sep::CliqueId, numtype> &kv : clique_pi) {
+        numtype pival = kv.second;
+        if (pival == 0.0)
+            continue;
+
+        for (int ind : *ext_cuts.clique_edges(kv.first))
+            core_edges[ind].redcost -= pival;
+    }
+
+    try {
+        price_dominos(core_edges, 0, ecount, *duals);
+    } CMR_CATCH_PRINT_THROW("pricing domino cuts", err);
 }
 
 }
@@ -35,6 +35,7 @@ public:
 protected:
     void fetch_next();
     void enqueue_split(BranchNode::Split prob_array);
+    void rebuild_queue(BranchHistory::iterator cur);
 
 private:
     std::priority_queue<BranchHistory::iterator,
@@ -61,13 +62,24 @@ void QprefBrancher<q_pref>::enqueue_split(BranchNode::Split prob_array) try
 {
     for (BranchNode &B : prob_array) {
         branch_history.emplace_front(std::move(B));
-        prob_q.push(branch_history.begin());
+        if (!branch_history.front().visited())
+            prob_q.push(branch_history.begin());
     }
 } catch (const std::exception &e) {
     std::cerr << e.what() << " putting nodes in history" << std::endl;
     throw std::runtime_error("QprefBrancher::enqueue_split failed.");
 }
 
+template <BranchNode::Pref q_pref>
+void QprefBrancher<q_pref>::rebuild_queue(BranchHistory::iterator cur)
+{
+    prob_q = decltype(prob_q)(q_pref);
+
+    for (auto it = branch_history.begin(); it != branch_history.end(); ++it)
+        if (it != cur && !it->visited())
+            prob_q.push(it);
+}
+
 template <BranchNode::Pref q_pref>
 BranchHistory::iterator QprefBrancher<q_pref>::next_prob()
 {
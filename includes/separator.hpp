@@ -30,6 +30,13 @@ public:
               Data::SupportGroup &suppdata,
               Data::KarpPartition &kpart, int seed);
 
+    /// Construct a Separator that gets TourGraphs from a shared cache.
+    Separator(const std::vector<Graph::Edge> &core_edges_,
+              const LP::ActiveTour &active_tour_,
+              Data::SupportGroup &suppdata,
+              Data::KarpPartition &kpart, int seed,
+              TourGraphCache &tg_cache_);
+
     bool segment_sep();
     bool fast2m_sep();
     bool blkcomb_sep();
@@ -37,6 +44,9 @@ public:
 
     bool simpleDP_sep();
 
+    /// Run segment, fast blossom, and block comb separation concurrently.
+    bool concurrent_sep(bool do_segment, bool do_fast2m, bool do_blkcomb);
+
     bool connect_sep();
     bool exsub_sep();
 
@@ -54,6 +64,9 @@ public:
     CutQueue<ex_blossom> &exblossom_q()  { return ex2m_q; }
     CutQueue<dominoparity> &simpleDP_q()  { return dp_q; }
 
+    /// The merged cuts found by concurrent_sep.
+    LPcutList &concurrent_q() { return conc_q; }
+
     LPcutList &connect_cuts_q()  { return connect_q; }
     LPcutList &exact_sub_q() { return exsub_q; }
 
@@ -68,14 +81,19 @@ public:
     bool verbose = false;
 
 private:
-    void set_TG(); //!< Construct the TourGraph TG.
+    TourGraph &tour_graph(); //!< A TourGraph for the active tour and edges.
+
+    bool segment_find(TourGraph &tour_graph); //!< Segment cuts wrt tour_graph.
+    bool fast2m_find(TourGraph &tour_graph); //!< Fast blossoms wrt tour_graph.
+    bool blkcomb_find(TourGraph &tour_graph); //!< Block combs wrt tour_graph.
 
     const std::vector<Graph::Edge> &core_edges;
     const LP::ActiveTour &active_tour;
     Data::SupportGroup &supp_data;
     Data::KarpPartition &karp_part;
 
-    TourGraph TG;
+    TourGraphCache *tg_cache = nullptr; //!< Shared TourGraph source, if any.
+    TourGraph own_TG; //!< TourGraph used if there is no tg_cache.
 
     std::vector<int> perm_elist;
 
@@ -84,6 +102,7 @@ private:
     LPcutList seg_q;
     LPcutList fast2m_q;
     LPcutList blkcomb_q;
+    LPcutList conc_q;
 
     CutQueue<ex_blossom> ex2m_q;
     CutQueue<dominoparity> dp_q;
@@ -29,6 +29,10 @@ public:
     int verbose = 0;
 
 private:
+    /// Karp partition indices in decreasing order of witness graph size.
+    std::vector<int> part_schedule() const;
+
+    const LP::ActiveTour &act_tour;
     CandidateTeeth candidates;
     Data::KarpPartition &kpart;
     CutQueue<dominoparity> &dp_q;
@@ -12,6 +12,7 @@
 #include "separator.hpp"
 #include "meta_sep.hpp"
 #include "abc_nodesel.hpp"
+#include "checkpoint.hpp"
 
 #include "pricer.hpp"
 #include "err_util.hpp"
@@ -55,10 +56,20 @@ public:
     Solver(int seed, int node_count, int gridsize, OutPrefs outprefs);
     ///@}
 
+    /// Resume an ABC search from a checkpoint file of TSPLIB instance.
+    /// The search continues on the next call to abc, which should use the
+    /// same node selection rule and pricing as the search that was saved.
+    Solver(const std::string &tsp_fname, const std::string &ckpt_fname,
+           OutPrefs outprefs);
+
     ~Solver();
 
     void set_lowerbound(double lb); //!< Set a target for early termination.
 
+    /// Set how the LP solver may use threads in long reoptimizations.
+    void set_thread_policy(const LP::ThreadPolicy &policy)
+        { core_lp.set_thread_policy(policy); }
+
     /// Run a primal cutting plane loop of pivoting and cut generation.
     LP::PivType cutting_loop(bool do_price, bool try_recover,
                              bool pure_cut);
@@ -127,10 +138,24 @@ public:
     const std::vector<AugObj> &get_aug_chart() const { return aug_chart; }
 
 private:
+    /// Rebuild a Solver from \p ckpt, to resume its search in abc.
+    Solver(const std::string &tsp_fname,
+           std::unique_ptr<Data::Checkpoint> ckpt, OutPrefs outprefs);
+
     void report_lp(LP::PivType piv); //!< Report on \p piv and core_lp.
     void report_cuts(); //!< Report the number and types of cuts in CoreLP.
     void report_aug(Aug aug_type); //!< Output info about a new tour found.
     void initial_prints(); //!< Handles writing initial data to file.
+    void load_cut_pool(); //!< Load the OutPrefs::pool_file cut pool.
+
+    /// Restore the cuts and active tour of \p ckpt in core_lp.
+    void restore_checkpoint(const Data::Checkpoint &ckpt);
+
+    /// Write OutPrefs::checkpoint_file if one is due, with \p cur next.
+    void checkpoint(const ABC::BranchNode &cur);
+
+    /// Restore the pricer and branch history of resume_point in abc.
+    void resume_abc(bool do_price);
 
     std::string file_infix(); //!< Returns an infix for data saved to file.
 
@@ -202,12 +227,20 @@ private:
 
     LP::CoreLP core_lp;
 
+    /// TourGraph shared by separators until the tour or edges change.
+    Sep::TourGraphCache tg_cache;
+
     std::unique_ptr<Price::Pricer> edge_pricer;
 
     std::unique_ptr<ABC::BaseBrancher> branch_controller;
 
     bool branch_engaged = false; //!< Is an ABC search active.
 
+    /// Checkpoint of a search to be resumed by abc, if any.
+    std::unique_ptr<Data::Checkpoint> resume_point;
+
+    double last_checkpoint = 0.0; //!< Real time of the last checkpoint.
+
     OutPrefs output_prefs;
 
     int num_augs = 0;
@@ -231,6 +264,7 @@ private:
         {"FastBlossoms", {Timer("FastBlossoms", &time_overall), false}},
         {"ExactBlossoms", {Timer("FastBlossoms", &time_overall), false}},
         {"BlockCombs", {Timer("BlockCombs", &time_overall), false}},
+        {"SegFastBlock", {Timer("SegFastBlock", &time_overall), false}},
         {"SimpleDP", {Timer("SimpleDP", &time_overall), false}},
         {"LocalCuts", {Timer("LocalCuts", &time_overall), false}},
         {"Decker", {Timer("Decker", &time_overall), false}},
@@ -268,39 +302,43 @@ LP::PivType Solver::abc(bool do_price)
 
     PivType piv = PivType::Frac;
 
-    try { piv = cutting_loop(do_price, true, true); }
-    CMR_CATCH_PRINT_THROW("running cutting_loop", err);
-
-    if (piv != PivType::Frac) {
-        if (piv == PivType::FathomedTour) {
-            return piv;
+    if (!resume_point) {
+        try { piv = cutting_loop(do_price, true, true); }
+        CMR_CATCH_PRINT_THROW("running cutting_loop", err);
+
+        if (piv != PivType::Frac) {
+            if (piv == PivType::FathomedTour) {
+                return piv;
+            }
+            else {
+                cerr << "Pivot status " << piv << " in abc.\n";
+                throw runtime_error("Invalid pivot type for running "
+                                    "Solver::abc.");
+            }
         }
-        else {
-            cerr << "Pivot status " << piv << " in abc.\n";
-            throw runtime_error("Invalid pivot type for running Solver::abc.");
+
+        if (do_price) {
+            try {
+                time_price.resume();
+                edge_pricer->elim_edges(true);
+                core_lp.full_opt();
+                time_price.stop();
+                cout << "\tcol count " << core_lp.num_cols()
+                     << ", opt objval " << core_lp.get_objval() << endl;
+            } CMR_CATCH_PRINT_THROW("eliminating and optimizing", err);
+        } else {
+            try {
+                core_lp.full_opt();
+            } CMR_CATCH_PRINT_THROW("optimizing at root", err);
+            cout << "\tRoot LP optimized with obj val "
+                 << core_lp.get_objval() << endl;
         }
-    }
 
-    if (do_price) {
-        try {
-            time_price.resume();
-            edge_pricer->elim_edges(true);
-            core_lp.primal_opt();
-            time_price.stop();
-            cout << "\tcol count " << core_lp.num_cols()
-                 << ", opt objval " << core_lp.get_objval() << endl;
-        } CMR_CATCH_PRINT_THROW("eliminating and optimizing", err);
+        cout << "\tCommencing ABC search....\n";
     } else {
-        try {
-            core_lp.primal_opt();
-        } CMR_CATCH_PRINT_THROW("optimizing at root", err);
-        cout << "\tRoot LP optimized with obj val " << core_lp.get_objval()
-             << endl;
+        cout << "\tResuming ABC search from checkpoint....\n";
     }
 
-
-    cout << "\tCommencing ABC search....\n";
-
     try {
         branch_controller = util::make_unique<SelectionRule>(tsp_instance,
                                                              best_info(),
@@ -318,6 +356,13 @@ LP::PivType Solver::abc(bool do_price)
         CMR_CATCH_PRINT_THROW("dumping gmi cuts before abc", err);
     }
 
+    if (resume_point) {
+        try { resume_abc(do_price); }
+        CMR_CATCH_PRINT_THROW("restoring checkpointed search", err);
+    }
+
+    last_checkpoint = util::real_zeit();
+
     try { piv = abc_bcp(do_price); }
     CMR_CATCH_PRINT_THROW("running abc_bcp", err);
 
@@ -325,14 +370,9 @@ LP::PivType Solver::abc(bool do_price)
          << best_data.min_tour_value << endl;
 
 
-    int max_depth = 0;
-    const ABC::BranchHistory &BH = branch_controller->get_history();
-    for (const auto &B : BH)
-        if (B.depth > max_depth)
-            max_depth = B.depth;
-
-    cout << "\t" << BH.size() << " branch nodes, max depth "
-         << max_depth << endl;
+    cout << "\t" << branch_controller->node_count()
+         << " branch nodes, max depth " << branch_controller->max_depth()
+         << endl;
 
     report_cuts();
 
@@ -52,7 +52,8 @@ public:
 
     std::vector<ToothList> light_teeth;
 
-    static std::vector<IteratorMat> seen_ranges;
+    /// For each root, iterators marking the tooth ranges already seen.
+    std::vector<IteratorMat> seen_ranges;
     std::vector<std::array<int, 3>> list_sizes;
 
 private:
@@ -52,6 +52,16 @@ struct OutPrefs {
 
     /// Detailed timer/profiling of the code.
     bool detailed_stats = false;
+
+    /// Binary cut pool file loaded by the Solver constructor and saved by
+    /// its destructor, if nonempty.
+    std::string pool_file;
+
+    /// File for periodic checkpoints of an ABC search, if nonempty.
+    std::string checkpoint_file;
+
+    /// Minimum number of seconds between writes of checkpoint_file.
+    double checkpoint_interval = 1800.0;
 };
 
 
@@ -6,6 +6,7 @@
 #include "process_cuts.hpp"
 
 
+#include <atomic>
 #include <vector>
 
 extern "C" {
@@ -26,6 +27,10 @@ public:
     /// Create a cutgraph and grab odd cuts from it.
     bool simple_DP_sep(CutQueue<dominoparity> &domino_q);
 
+    /// As above, but stop early if \p cancel is set by another thread.
+    bool simple_DP_sep(CutQueue<dominoparity> &domino_q,
+                       const std::atomic<bool> &cancel);
+
 private:
     void build_light_tree();  //!< Build the tooth inequality tree.
     void add_web_edges(); //!< Add nonnegativity inequality edges.
@@ -37,7 +42,8 @@ private:
     void expand_cut(CC_GHnode *n, std::vector<int> &cut_nodes);
 
     /// Get simple DP inequalities from fundamental cuts of the GH tree.
-    void grab_dominos(CutQueue<dominoparity> &domino_q);
+    void grab_dominos(CutQueue<dominoparity> &domino_q,
+                      const std::atomic<bool> *cancel);
 
     std::vector<std::vector<SimpleTooth>> light_teeth;
 
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <iostream>
 #include <stdexcept>
+#include <unordered_map>
 
 using std::cout;
 using std::cerr;
@@ -33,6 +34,63 @@ try : instance(inst), best_data(bestdata), core_graph(coregraph), core_lp(core),
     throw runtime_error("BaseBrancher constructor failed.");
 }
 
+/**
+ * The nodes of \p history are spliced into branch_history, replacing the root
+ * made by the constructor, so iterators and parent pointers into \p history
+ * remain valid. The clamps of all the ancestors of \p cur are then done,
+ * leaving the LP as it was when next_prob returned \p cur in the search
+ * being resumed.
+ * @param history a search tree, as saved in a Data::Checkpoint. It is left
+ * empty.
+ * @param cur an unvisited node of \p history.
+ */
+void BaseBrancher::resume(BranchHistory &history, BranchHistory::iterator cur)
+{
+    runtime_error err("Problem in BaseBrancher::resume");
+
+    if (cur == history.end() || cur->visited())
+        throw runtime_error("BaseBrancher::resume with visited cur");
+
+    branch_history.clear();
+    branch_history.splice(branch_history.end(), history);
+
+    families.clear();
+    total_nodes = branch_history.size();
+    deepest = 0;
+
+    try {
+        std::unordered_map<const BranchNode *, BranchHistory::iterator> itrs;
+
+        for (auto it = branch_history.begin(); it != branch_history.end();
+             ++it) {
+            itrs.emplace(&*it, it);
+            deepest = std::max(deepest, it->depth);
+        }
+
+        for (const BranchNode &B : branch_history)
+            if (!B.is_root()) {
+                auto fam = families.emplace(B.parent,
+                                            Family{itrs.at(B.parent), 0});
+                ++fam.first->second.live_children;
+            }
+    } CMR_CATCH_PRINT_THROW("counting node children", err);
+
+    vector<const BranchNode *> ancestors;
+
+    for (const BranchNode *B = cur->parent; B != nullptr; B = B->parent)
+        ancestors.push_back(B);
+
+    try {
+        for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it)
+            exec.clamp(**it);
+    } CMR_CATCH_PRINT_THROW("clamping ancestors of resumed node", err);
+
+    try { rebuild_queue(cur); }
+    CMR_CATCH_PRINT_THROW("rebuilding node queue", err);
+
+    next_itr = cur;
+}
+
 void BaseBrancher::split_prob(BranchHistory::iterator &current)
 {
     runtime_error err("Problem in BaseBrancher::next_level");
@@ -53,6 +111,25 @@ void BaseBrancher::split_prob(BranchHistory::iterator &current)
         enqueue_split(std::move(prob_array));
     } CMR_CATCH_PRINT_THROW("adding child problems to queue", err);
 
+    int live_children = 0;
+
+    for (auto it = branch_history.begin();
+         it != branch_history.end() && it->parent == &*current;)
+        if (it->visited()) {
+            it = branch_history.erase(it);
+        } else {
+            ++live_children;
+            ++it;
+        }
+
+    try {
+        if (live_children > 0)
+            families.emplace(&*current, Family{current, live_children});
+    } CMR_CATCH_PRINT_THROW("recording node family", err);
+
+    total_nodes += 2;
+    deepest = std::max(deepest, current->depth + 1);
+
     int num_remain = 0;
 
     if (verbose)
@@ -116,6 +193,44 @@ void BaseBrancher::do_unbranch(const BranchNode &B)
     } CMR_CATCH_PRINT_THROW("calling common_prep_next", err);
 }
 
+/**
+ * Nodes are only needed in branch_history while they are unvisited or have
+ * unvisited descendants, since common_prep_next and branch tour computation
+ * only follow BranchNode::parent pointers from those. This should be called
+ * on each examined node after do_unbranch, and keeps the size of
+ * branch_history proportional to the number of open nodes times their
+ * depth, rather than to the number of nodes examined.
+ * @param done a visited node; iterators and references to it and to any
+ * erased ancestors are invalidated.
+ */
+void BaseBrancher::reclaim(BranchHistory::iterator done)
+{
+    if (!done->visited())
+        throw runtime_error("Calling reclaim on unvisited " +
+                            bnode_brief(*done));
+
+    if (families.count(&*done) != 0)
+        return;
+
+    while (true) {
+        const BranchNode *parent = done->parent;
+
+        branch_history.erase(done);
+        if (parent == nullptr)
+            return;
+
+        auto fam = families.find(parent);
+        if (fam == families.end())
+            throw runtime_error("Reclaimed node parent has no family");
+
+        if (--fam->second.live_children > 0)
+            return;
+
+        done = fam->second.itr;
+        families.erase(fam);
+    }
+}
+
 /**
  * @param done the node that was just examined.
  * @param next the next node as per the current node selection rule.
@@ -0,0 +1,80 @@
+#include "batch.hpp"
+#include "abc_nodesel.hpp"
+#include "config.hpp"
+
+#include <iostream>
+#include <stdexcept>
+
+#if CMR_USE_OMP
+#include <omp.h>
+#endif
+
+using std::vector;
+
+using std::cerr;
+using std::exception;
+using std::runtime_error;
+
+namespace CMR {
+
+/// Construct a Solver for \p job and run it, recording the outcome.
+static void run_job(const BatchJob &job, BatchResult &result)
+{
+    double t = util::real_zeit();
+
+    try {
+        Solver solver(job.tsp_fname, job.seed, job.outprefs);
+        solver.choose_cuts(job.cut_preset);
+
+        if (job.branch)
+            result.piv = solver.abc<ABC::InterBrancher>(job.do_price);
+        else
+            result.piv = solver.cutting_loop(job.do_price, true, true);
+
+        result.tour_val = solver.best_info().min_tour_value;
+        result.solved = true;
+    } catch (const exception &e) {
+        result.solved = false;
+        result.error = e.what();
+    }
+
+    result.time = util::real_zeit() - t;
+}
+
+/**
+ * Each job gets its own Solver, so no state is shared between jobs apart
+ * from stdout. With CMR_USE_OMP set, the jobs are handed out dynamically to a
+ * team of \p num_threads OMP threads; parallel regions inside a Solver then
+ * run serially unless nested parallelism has been enabled. Without OMP the
+ * jobs are solved one after another. A job that throws does not stop the
+ * batch; its message is recorded in the corresponding BatchResult.
+ * @param jobs the instances to solve.
+ * @param num_threads the number of jobs to solve at once, at least 1.
+ * @returns a vector of results, one for each entry of \p jobs.
+ */
+vector<BatchResult> solve_batch(const vector<BatchJob> &jobs, int num_threads)
+{
+    if (num_threads < 1)
+        throw runtime_error("solve_batch called with num_threads < 1");
+
+    vector<BatchResult> results(jobs.size());
+    int job_count = jobs.size();
+
+#if !(CMR_USE_OMP)
+    for (int i = 0; i < job_count; ++i)
+        run_job(jobs[i], results[i]);
+#else
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads)
+    for (int i = 0; i < job_count; ++i)
+        run_job(jobs[i], results[i]);
+#endif
+
+    for (int i = 0; i < job_count; ++i)
+        if (!results[i].solved)
+            cerr << "Batch job " << jobs[i].tsp_fname << " failed: "
+                 << results[i].error << "\n";
+
+    return results;
+}
+
+}
@@ -1,5 +1,4 @@
 #include "blossoms.hpp"
-#include "config.hpp"
 #include "err_util.hpp"
 #include "util.hpp"
 
@@ -7,6 +6,7 @@ extern "C" {
   #include <concorde/INCLUDE/cut.h>
 }
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <stdexcept>
@@ -32,8 +32,15 @@ ExBlossoms::ExBlossoms(const vector<Graph::Edge> &_edges,
     active_tour(active_tour_), supp_data(s_dat), blossom_q(_blossom_q) {}
 
 
-#if !(CMR_USE_OMP)
-///////////////////////// SERIAL IMPLEMENTATION ///////////////////////////////
+/**
+ * With tour edges weighted 1 - x_e and all others x_e, every cut crosses an
+ * even number of tour edges. A primal blossom with cut edge e is a cut
+ * separating the ends of e, with e's weight flipped to make the teeth odd;
+ * since e is in every such cut, the flip just adds a constant to their
+ * weight. So the best handle for e is a minimum cut between its ends under
+ * the unflipped weights, and these are all read off a single Gomory-Hu tree:
+ * the cheapest tree edge on the path between the ends of e gives the cut.
+ */
 bool ExBlossoms::find_cuts() {
     runtime_error err("Problem in ExBlossoms::find_cuts");
 
@@ -53,210 +60,116 @@ bool ExBlossoms::find_cuts() {
             cut_ecap[i] = 1 - sup_ecap[i];
     }
 
-    vector<ex_blossom> intermediate_cuts;
     int ncount = active_tour.nodes().size();
+    int ecount = sup_inds.size();
 
-    for (auto i = 0; i < sup_inds.size(); ++i) {
-        int cut_ind = sup_inds[i];
-        int tour_entry = tour_edges[cut_ind];
-        EndPts e(sup_elist[2 * i], sup_elist[(2 * i) + 1]);
-
-        int cut_count = 0;
-        int *cut_nodes = (int *) NULL;
-        double orig_weight = 1.0;
-        double changed_weight = 1.0;
-        double cut_val = 1.0;
-
-        if (tour_entry == 0) {
-            orig_weight = sup_ecap[i];
-            changed_weight = 1 - sup_ecap[i];
-        } else if (tour_entry == 1) {
-            orig_weight = 1 - sup_ecap[i];
-            changed_weight = sup_ecap[i];
-        }
-
-        cut_ecap[i] = changed_weight;
-
-        //reverts cut_ecap when it goes out of scope.
-        auto ecap_guard = util::make_guard([&cut_ecap, i, orig_weight]
-                                           { cut_ecap[i] = orig_weight; });
-
-        if (CCcut_mincut_st(ncount, sup_inds.size(),
-                            &sup_elist[0], &cut_ecap[0],
-                            e.end[0], e.end[1],
-                            &cut_val, &cut_nodes, &cut_count)) {
-            cerr << "CCcut_mincut_st failed.\n";
-            throw err;
-        }
-
-        //frees cut nodes when it goes out of scope
-        util::c_array_ptr<int> cnodes_ptr(cut_nodes);
-
-        if (cut_val >= 1.0 - Eps::MinCut || cut_count < 3)
-            continue;
-
-        vector<int> handle;
-
-        try {
-            for (int j = 0; j < cut_count; ++j)
-                handle.push_back(cut_nodes[j]);
-            intermediate_cuts.emplace_back(handle, cut_ind, cut_val);
-        } CMR_CATCH_PRINT_THROW("copying handle/emplacing intemrediate", err);
-    }
-
-    // cout << "Ended with intermediate cuts size " << intermediate_cuts.size()
-    //      << "\n";
-
-    if (intermediate_cuts.empty())
-        return false;
-
-    const vector<double> &lp_vec = supp_data.lp_vec;
+    CC_GHtree gh_tree;
+    CCcut_GHtreeinit(&gh_tree);
+    auto tree_guard = util::make_guard([&gh_tree]
+                                       { CCcut_GHtreefree(&gh_tree); });
 
+    vector<int> all_nodes;
     try {
-        intermediate_cuts.erase(std::remove_if(intermediate_cuts.begin(),
-                                               intermediate_cuts.end(),
-                                               [this, &tour_edges, &lp_vec,
-                                                ncount]
-                                               (const ex_blossom &B)
-                                               {
-                                                   return
-                                                   bad_blossom(B, tour_edges,
-                                                               lp_vec, edges,
-                                                               ncount);
-                                               }),
-                                intermediate_cuts.end());
-    } CMR_CATCH_PRINT_THROW("filtering bad blossoms", err);
-
-    if (intermediate_cuts.empty()) {
-        // cout << "\n|||Cuts were found but had to be cleaned up|||\n\n";
-        return false;
-    }
+        all_nodes.resize(ncount);
+        for (int i = 0; i < ncount; ++i)
+            all_nodes[i] = i;
+    } CMR_CATCH_PRINT_THROW("allocating node marks", err);
 
-    std::sort(intermediate_cuts.begin(), intermediate_cuts.end(),
-              [](const ex_blossom &B, const ex_blossom &C)
-              { return B.cut_val < C.cut_val; });
+    CCrandstate rstate; // only used to break ties in the tree
+    CCutil_sprand(99, &rstate);
 
-    for (auto it = intermediate_cuts.rbegin(); it != intermediate_cuts.rend();
-         ++it) {
-        blossom_q.push_front(*it);
+    if (CCcut_gomory_hu(&gh_tree, ncount, ecount, &sup_elist[0], &cut_ecap[0],
+                        ncount, &all_nodes[0], &rstate)) {
+        cerr << "CCcut_gomory_hu failed.\n";
+        throw err;
     }
 
-    return true;
-}
-
-#else
-//////////////////////// OMP PARALLEL IMPLEMENTATION /////////////////////////
-bool ExBlossoms::find_cuts() {
-    runtime_error err("Problem in ExBlossoms::find_cuts");
-
-    vector<int> &sup_inds = supp_data.support_indices;
-    vector<double> &sup_ecap = supp_data.support_ecap;
-    vector<int> &sup_elist = supp_data.support_elist;
-    const vector<double> &tour_edges = active_tour.edges();
+    int tree_count = gh_tree.supernodecount;
+    CC_GHnode *tree_nodes = gh_tree.supernodes;
 
-    vector<double> cut_ecap;
+    vector<int> tree_ind; // tree_ind[v] is the tree node containing v.
+    vector<int> depth;
+    vector<vector<int>> handles; // Cut shores, expanded as needed.
 
-    try { cut_ecap = sup_ecap; }
-    CMR_CATCH_PRINT_THROW("copying cut ecap", err);
+    try {
+        tree_ind.resize(ncount, -1);
+        depth.resize(tree_count, 0);
+        handles.resize(tree_count);
+
+        for (int k = 0; k < tree_count; ++k) {
+            const CC_GHnode &n = tree_nodes[k];
+            for (int j = 0; j < n.listcount; ++j)
+                tree_ind[n.nlist[j]] = k;
+        }
 
-    for (auto i = 0; i < sup_inds.size(); ++i) {
-        int index = sup_inds[i];
-        if (tour_edges[index] > 1 - Eps::Zero)
-            cut_ecap[i] = 1 - sup_ecap[i];
-    }
+        vector<CC_GHnode *> dfs_stack{gh_tree.root};
+        while (!dfs_stack.empty()) {
+            CC_GHnode *n = dfs_stack.back();
+            dfs_stack.pop_back();
+            for (CC_GHnode *c = n->child; c; c = c->sibling) {
+                depth[c - tree_nodes] = depth[n - tree_nodes] + 1;
+                dfs_stack.push_back(c);
+            }
+        }
+    } CMR_CATCH_PRINT_THROW("indexing gomory hu tree", err);
 
     vector<ex_blossom> intermediate_cuts;
-    int ncount = active_tour.nodes().size();
-
-    int flag_rval = 0;
-
-    #pragma omp parallel for
-    for (auto i = 0; i < sup_inds.size(); ++i) {
-        if (flag_rval)
-            continue;
 
+    for (auto i = 0; i < ecount; ++i) {
         int cut_ind = sup_inds[i];
         int tour_entry = tour_edges[cut_ind];
-        EndPts e(sup_elist[2 * i], sup_elist[(2 * i) + 1]);
-
-        int cut_count = 0;
-        int *cut_nodes = (int *) NULL;
-        double cut_val = 1.0;
+        int u = tree_ind[sup_elist[2 * i]];
+        int v = tree_ind[sup_elist[(2 * i) + 1]];
 
-        vector<double> current_ecap;
-
-        try { current_ecap = cut_ecap; } catch (const exception &e) {
-            #pragma omp critical
-            {
-                flag_rval = 1;
-                cerr << e.what() << " copying for current_ecap\n";
-            }
-        }
-        if (flag_rval)
+        if (u == v || u == -1 || v == -1)
             continue;
 
-        if (tour_entry == 0) {
-            current_ecap[i] = 1 - sup_ecap[i];
-        } else if (tour_entry == 1) {
-            current_ecap[i] = sup_ecap[i];
-        }
-
-        if (CCcut_mincut_st(ncount, sup_inds.size(),
-                            &sup_elist[0], &cut_ecap[0],
-                            e.end[0], e.end[1],
-                            &cut_val, &cut_nodes, &cut_count)) {
-            #pragma omp critical
-            {
-                cerr << "CCcut_mincut_st failed\n";
-                flag_rval = 1;
+        double flip_delta = 0.0;
+        if (tour_entry == 0)
+            flip_delta = 1 - 2 * sup_ecap[i];
+        else if (tour_entry == 1)
+            flip_delta = 2 * sup_ecap[i] - 1;
+
+        // min weight tree edge on the u-v path, identified by its child end
+        int best = -1;
+        double best_val = 0.0;
+
+        while (u != v) {
+            int &deeper = (depth[u] >= depth[v]) ? u : v;
+            const CC_GHnode &n = tree_nodes[deeper];
+            if (best == -1 || n.cutval < best_val) {
+                best = deeper;
+                best_val = n.cutval;
             }
+            deeper = n.parent - tree_nodes;
         }
-        if (flag_rval)
-            continue;
 
-        //frees cut nodes when it goes out of scope
-        util::c_array_ptr<int> cnodes_ptr(cut_nodes);
-
-        if (cut_val >= 1.0 - Eps::MinCut || cut_count < 3)
+        double cut_val = best_val + flip_delta;
+        if (cut_val >= 1.0 - Eps::MinCut)
             continue;
 
-        vector<int> handle;
+        vector<int> &handle = handles[best];
 
         try {
-            for (int j = 0; j < cut_count; ++j)
-                handle.push_back(cut_nodes[j]);
-        } catch(const exception &e) {
-            #pragma omp critical
-            {
-                cerr << e.what() << " copying handle\n";
-                flag_rval = 1;
+            if (handle.empty()) {
+                vector<CC_GHnode *> sub_stack{&tree_nodes[best]};
+                while (!sub_stack.empty()) {
+                    CC_GHnode *n = sub_stack.back();
+                    sub_stack.pop_back();
+                    for (int j = 0; j < n->listcount; ++j)
+                        handle.push_back(n->nlist[j]);
+                    for (CC_GHnode *c = n->child; c; c = c->sibling)
+                        sub_stack.push_back(c);
+                }
             }
-        }
-        if (flag_rval)
-            continue;
 
-        try {
-            #pragma omp critical
-            {
-                intermediate_cuts.emplace_back(handle, cut_ind, cut_val);
-            }
-        } catch (const exception &e) {
-            #pragma omp critical
-            {
-                cerr << e.what() << " emplacing intermediate\n";
-                flag_rval = 1;
-            }
-        }
-    }
+            if (handle.size() < 3)
+                continue;
 
-    if (flag_rval) {
-        cerr << "Flag rval set by error in loop\n";
-        throw err;
+            intermediate_cuts.emplace_back(handle, cut_ind, cut_val);
+        } CMR_CATCH_PRINT_THROW("copying handle/emplacing intemrediate", err);
     }
 
-    // cout << "Ended with intermediate cuts size " << intermediate_cuts.size()
-    //      << "\n";
-
     if (intermediate_cuts.empty())
         return false;
 
@@ -277,10 +190,8 @@ bool ExBlossoms::find_cuts() {
                                 intermediate_cuts.end());
     } CMR_CATCH_PRINT_THROW("filtering bad blossoms", err);
 
-    if (intermediate_cuts.empty()) {
-        // cout << "\n|||Cuts were found but had to be cleaned up|||\n\n";
+    if (intermediate_cuts.empty())
         return false;
-    }
 
     std::sort(intermediate_cuts.begin(), intermediate_cuts.end(),
               [](const ex_blossom &B, const ex_blossom &C)
@@ -294,7 +205,5 @@ bool ExBlossoms::find_cuts() {
     return true;
 }
 
-#endif // CMR_USE_OMP
-
 }
 }
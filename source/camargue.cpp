@@ -12,6 +12,7 @@
 #include "io_util.hpp"
 #include "timer.hpp"
 
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -55,6 +56,9 @@ struct OptData {
     bool sparse = false;
     bool branch = true;
 
+    int lp_threads = 1;
+    int lp_mode = 0;
+
     double target_lb{large_neg};
 };
 
@@ -90,7 +94,14 @@ int main(int argc, char** argv) try
     CMR::Timer t("Ctors/Solution");
     t.start();
 
-    if (!tsp_fname.empty()) {
+    const string &ckpt_fname = outprefs.checkpoint_file;
+
+    if (!tsp_fname.empty() && !ckpt_fname.empty() &&
+        std::ifstream(ckpt_fname).good()) {
+        cout << "Resuming from checkpoint " << ckpt_fname << endl;
+        tsp_solver = CMR::util::make_unique<CMR::Solver>(tsp_fname, ckpt_fname,
+                                                         outprefs);
+    } else if (!tsp_fname.empty()) {
         if (tour_fname.empty())
             tsp_solver = CMR::util::make_unique<CMR::Solver>(tsp_fname, seed,
                                                              ep,
@@ -108,6 +119,11 @@ int main(int argc, char** argv) try
     if (opt_dat.target_lb != large_neg)
         tsp_solver->set_lowerbound(opt_dat.target_lb);
 
+    CMR::LP::ThreadPolicy lp_policy;
+    lp_policy.threads = opt_dat.lp_threads;
+    lp_policy.mode = static_cast<CMR::LP::ThreadPolicy::Mode>(opt_dat.lp_mode);
+    tsp_solver->set_thread_policy(lp_policy);
+
     using SelPreset = CMR::Solver::CutSel::Presets;
     int &cut_sel = opt_dat.cut_sel;
     bool &sparse = opt_dat.sparse;
@@ -171,7 +187,7 @@ static void initial_parse(int ac, char **av, OptData &opt_dat,
         throw logic_error("No arguments specified");
     }
 
-    while ((c = getopt(ac, av, "aBEGPRSTVXb:c:e:l:n:g:s:t:")) != EOF) {
+    while ((c = getopt(ac, av, "aBEGPRSTVXb:c:e:i:j:k:l:m:n:g:p:s:t:")) != EOF) {
         switch (c) {
         case 'B':
             outprefs.prog_bar = true;
@@ -210,15 +226,30 @@ static void initial_parse(int ac, char **av, OptData &opt_dat,
         case 'e':
             opt_dat.edge_sel = atoi(optarg);
             break;
+        case 'i':
+            outprefs.checkpoint_interval = atof(optarg);
+            break;
+        case 'j':
+            opt_dat.lp_threads = atoi(optarg);
+            break;
+        case 'k':
+            outprefs.checkpoint_file = optarg;
+            break;
         case 'l':
             opt_dat.target_lb = atof(optarg);
             break;
+        case 'm':
+            opt_dat.lp_mode = atoi(optarg);
+            break;
         case 'n':
             opt_dat.rand_nodes = atoi(optarg);
             break;
         case 'g':
             opt_dat.rand_grid = atoi(optarg);
             break;
+        case 'p':
+            outprefs.pool_file = optarg;
+            break;
         case 's':
             opt_dat.seed = atoi(optarg);
             break;
@@ -255,6 +286,16 @@ static void initial_parse(int ac, char **av, OptData &opt_dat,
         throw logic_error("Edge sel (-e) must be 0 or 1");
     }
 
+    if (opt_dat.lp_threads < 0) {
+        usage(av[0]);
+        throw logic_error("LP threads (-j) must be nonnegative");
+    }
+
+    if (opt_dat.lp_mode < 0 || opt_dat.lp_mode > 2) {
+        usage(av[0]);
+        throw logic_error("LP parallel mode (-m) must be 0, 1, or 2");
+    }
+
     if (opt_dat.tsp_fname.empty() && opt_dat.rand_nodes <= 0) {
         usage(av[0]);
         throw logic_error("Must specify problem file or random nodecount");
@@ -271,6 +312,11 @@ static void initial_parse(int ac, char **av, OptData &opt_dat,
         throw logic_error("Cannot specify tour without TSPLIB file.");
     }
 
+    if (opt_dat.tsp_fname.empty() && !outprefs.checkpoint_file.empty()) {
+        usage(av[0]);
+        throw logic_error("Cannot checkpoint without TSPLIB file.");
+    }
+
     if (outprefs.verbose && outprefs.prog_bar) {
         usage(av[0]);
         throw logic_error("Requested progress bar and verbose.");
@@ -322,8 +368,23 @@ static void usage(const std::string &fname)
          << "   \t Notes:\t If a Delaunay triangulation is requested with an\n"
          << "   \t incompatible norm, the Linkern edges will be used.\n"
          << "-g \t Random problem gridsize x by x (1 million default)\n"
+         << "-i \t Write checkpoints at most every x seconds (1800 default)\n"
+         << "-j \t Use x threads in long LP optimizations, 0 for auto "
+         << "(1 default)\n"
+         << "-k \t Checkpoint ABC search to file x, resuming from x if it "
+         << "exists.\n"
+         << "   \t Notes:\t Needs a TSPLIB file and the options of the "
+         << "saved run.\n"
          << "-l \t Target lower bound: report optimal if tour is at most x.\n"
+         << "-m \t Parallel mode x for long LP optimizations (see below).\n"
+         << "   \t 0\tDeterministic barrier (default).\n"
+         << "   \t 1\tOpportunistic barrier.\n"
+         << "   \t 2\tConcurrent primal/dual/barrier, opportunistic.\n"
+         << "   \t Notes:\t Used only if -j is not 1. Pivots and strong "
+         << "branching\n"
+         << "   \t always use one thread.\n"
          << "-n \t Random problem with x nodes\n"
+         << "-p \t Load cut pool from binary file x, and save it on exit\n"
          << "-s \t Random seed x used throughout code (current time default)\n"
          << "-t \t Load starting tour from path x" << endl;
 }
@@ -1,5 +1,7 @@
 #include "cc_lpcuts.hpp"
+#include "err_util.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
 #include <utility>
@@ -29,30 +31,51 @@ TourGraph::TourGraph(const vector<double> &tour_edges,
     : d_tour(tour_edges)
 {
     vector<int> elist;
-    int ncount = perm.size();
-    int ecount = edges.size();
 
     for (const Graph::Edge &e : edges) {
         elist.push_back(perm[e.end[0]]);
         elist.push_back(perm[e.end[1]]);
     }
 
-  CCtsp_init_lpgraph_struct(&L);
-
-  if (CCtsp_build_lpgraph(&L, ncount, ecount, &elist[0], (int *) NULL))
-      throw runtime_error("CCtsp_build_lpgraph failed.");
-
-  if (CCtsp_build_lpadj(&L, 0, ecount))
-      throw runtime_error("CCtsp_build_lpadj failed.");
+    build(elist, perm.size());
+} catch (const std::exception &e) {
+    cerr << e.what() << "\n";
+    throw runtime_error("TourGraph constructor failed.");
+}
 
+/**
+ * @param tour_edges the tour vector, indexed by edge.
+ * @param perm_elist the edges as pairs of tour positions, so that edge `i`
+ * has ends `perm_elist[2 * i]` and `perm_elist[2 * i + 1]`.
+ * @param ncount the number of nodes.
+ */
+TourGraph::TourGraph(const vector<double> &tour_edges,
+                     const vector<int> &perm_elist, int ncount) try
+    : d_tour(tour_edges)
+{
+    build(perm_elist, ncount);
 } catch (const std::exception &e) {
     cerr << e.what() << "\n";
     throw runtime_error("TourGraph constructor failed.");
 }
 
+void TourGraph::build(const vector<int> &perm_elist, int ncount)
+{
+    int ecount = perm_elist.size() / 2;
+
+    CCtsp_init_lpgraph_struct(&L);
+
+    if (CCtsp_build_lpgraph(&L, ncount, ecount,
+                            const_cast<int *>(perm_elist.data()),
+                            (int *) NULL))
+        throw runtime_error("CCtsp_build_lpgraph failed.");
+
+    if (CCtsp_build_lpadj(&L, 0, ecount))
+        throw runtime_error("CCtsp_build_lpadj failed.");
+}
+
 TourGraph::TourGraph(TourGraph &&T) noexcept : d_tour(std::move(T.d_tour))
 {
-    CCtsp_free_lpgraph(&L);
     L = T.L;
 
     CCtsp_init_lpgraph_struct(&T.L);
@@ -74,6 +97,61 @@ TourGraph &TourGraph::operator=(TourGraph &&T) noexcept
 
 TourGraph::~TourGraph() {  CCtsp_free_lpgraph(&L); }
 
+/**
+ * The cache is checked against \p perm and \p edges on every call, so it
+ * never needs to be invalidated explicitly. If the tour is unchanged, the
+ * longest prefix of the cached edge list that still matches \p edges is kept
+ * and only the remaining edges are permuted again; this is the common case
+ * of edges being added by pricing. The Concorde graph is rebuilt only if
+ * something differs.
+ * @param tour_edges the tour vector, indexed by edges.
+ * @param edges the core edges.
+ * @param perm the tour permutation, `perm[i]` being the tour position of i.
+ * @returns a reference to the cached TourGraph, valid until the next call.
+ */
+TourGraph &TourGraphCache::get(const vector<double> &tour_edges,
+                               const vector<Graph::Edge> &edges,
+                               const vector<int> &perm)
+{
+    runtime_error err("Problem in TourGraphCache::get");
+
+    int ecount = edges.size();
+    int keep = 0;
+
+    if (built && perm == tour_perm) {
+        int old_ecount = perm_elist.size() / 2;
+        int bound = std::min(ecount, old_ecount);
+        while (keep < bound) {
+            const Graph::Edge &e = edges[keep];
+            if (perm_elist[2 * keep] != perm[e.end[0]] ||
+                perm_elist[2 * keep + 1] != perm[e.end[1]])
+                break;
+            ++keep;
+        }
+
+        if (keep == old_ecount && keep == ecount)
+            return TG;
+    } else {
+        try { tour_perm = perm; }
+        CMR_CATCH_PRINT_THROW("copying perm", err);
+    }
+
+    try {
+        perm_elist.resize(2 * keep);
+        for (int i = keep; i < ecount; ++i) {
+            perm_elist.push_back(perm[edges[i].end[0]]);
+            perm_elist.push_back(perm[edges[i].end[1]]);
+        }
+
+        built = false;
+        TG = TourGraph(tour_edges, perm_elist, perm.size());
+        built = true;
+        ++builds;
+    } CMR_CATCH_PRINT_THROW("rebuilding TourGraph", err);
+
+    return TG;
+}
+
 
 LPcutList::LPcutList() noexcept : head_cut(), cutcount(0) {}
 
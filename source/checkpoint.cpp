@@ -0,0 +1,359 @@
+#include "checkpoint.hpp"
+#include "err_util.hpp"
+#include "util.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+using std::vector;
+using std::string;
+
+using std::cerr;
+using std::endl;
+
+using std::runtime_error;
+using std::exception;
+
+namespace CMR {
+namespace Data {
+
+using ABC::BranchNode;
+using ABC::BranchHistory;
+
+/// Leading bytes of a checkpoint file.
+static const char CkptMagic[8] = {'C', 'M', 'R', 'C', 'K', 'P', 'T', '\0'};
+
+constexpr std::int32_t CkptVersion = 1; //!< Current checkpoint file version.
+
+/// Write the value \p val to \p out.
+template <typename T>
+static void put(std::ofstream &out, const T &val)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "put needs a POD");
+    out.write(reinterpret_cast<const char *>(&val), sizeof(T));
+}
+
+/// Write the size of \p vec followed by its entries to \p out.
+template <typename T>
+static void put_vec(std::ofstream &out, const vector<T> &vec)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "put_vec needs a POD");
+    put(out, static_cast<std::uint64_t>(vec.size()));
+    out.write(reinterpret_cast<const char *>(vec.data()),
+              vec.size() * sizeof(T));
+}
+
+/// Read a value written by put from \p in into \p val.
+template <typename T>
+static void get(std::ifstream &in, T &val)
+{
+    if (!in.read(reinterpret_cast<char *>(&val), sizeof(T)))
+        throw runtime_error("Checkpoint file is truncated");
+}
+
+/// Read a vector written by put_vec from \p in into \p vec.
+/// @param fsize the size of the file, bounding the size of \p vec.
+template <typename T>
+static void get_vec(std::ifstream &in, vector<T> &vec, std::uint64_t fsize)
+{
+    std::uint64_t count = 0;
+    get(in, count);
+
+    if (count > fsize / sizeof(T))
+        throw runtime_error("Checkpoint file has bad vector size");
+
+    vec.resize(count);
+    if (!in.read(reinterpret_cast<char *>(vec.data()), count * sizeof(T)))
+        throw runtime_error("Checkpoint file is truncated");
+}
+
+static void put_basis(std::ofstream &out, const LP::Basis &base)
+{
+    put_vec(out, base.colstat);
+    put_vec(out, base.rowstat);
+}
+
+static void get_basis(std::ifstream &in, LP::Basis &base, std::uint64_t fsize)
+{
+    get_vec(in, base.colstat, fsize);
+    get_vec(in, base.rowstat, fsize);
+}
+
+/**
+ * The file is read fully and its sizes and indices are checked against each
+ * other. The cuts and tours are validated later, when they are used to
+ * rebuild a Solver.
+ * @throws std::runtime_error if \p fname cannot be read, was written by a
+ * different version, or is malformed.
+ */
+Checkpoint::Checkpoint(const string &fname)
+{
+    runtime_error err("Problem in Checkpoint constructor");
+
+    std::ifstream in(fname, std::ios::binary | std::ios::ate);
+    if (!in) {
+        cerr << "Couldn't open checkpoint file " << fname << endl;
+        throw err;
+    }
+
+    std::uint64_t fsize = in.tellg();
+    in.seekg(0);
+
+    try {
+        char magic[8];
+        std::int32_t version = 0;
+
+        get(in, magic);
+        get(in, version);
+
+        if (std::memcmp(magic, CkptMagic, sizeof(CkptMagic)) != 0 ||
+            version != CkptVersion)
+            throw runtime_error("Not a version " +
+                                std::to_string(CkptVersion) + " checkpoint");
+
+        vector<char> name;
+        get_vec(in, name, fsize);
+        probname.assign(name.begin(), name.end());
+
+        get(in, seed);
+        get(in, ncount);
+
+        get_vec(in, core_edges, fsize);
+        get_vec(in, best_tour, fsize);
+        get(in, best_value);
+
+        get_vec(in, cuts.ref_tour, fsize);
+        get_vec(in, cuts.clique_beg, fsize);
+        get_vec(in, cuts.segs, fsize);
+        get_vec(in, cuts.clique_sorted, fsize);
+        get_vec(in, cuts.cut_beg, fsize);
+        get_vec(in, cuts.clique_refs, fsize);
+        get_vec(in, cuts.tooth_beg, fsize);
+        get_vec(in, cuts.tooth_refs, fsize);
+        get_vec(in, cuts.sense, fsize);
+        get_vec(in, cuts.rhs, fsize);
+        get_vec(in, cuts.ages, fsize);
+        get(in, cuts.lp_count);
+
+        char tless = 0;
+        get_vec(in, active_tour, fsize);
+        get(in, tless);
+        tourless = tless;
+        get_basis(in, active_base, fsize);
+
+        std::uint64_t basecount = 0;
+        get_vec(in, nodes, fsize);
+        get(in, basecount);
+        if (basecount > nodes.size())
+            throw runtime_error("Too many node bases");
+
+        node_bases.resize(basecount);
+        for (LP::Basis &base : node_bases)
+            get_basis(in, base, fsize);
+        get(in, cur_node);
+
+        if (in.peek() != std::ifstream::traits_type::eof())
+            throw runtime_error("Trailing data");
+    } catch (const exception &e) {
+        cerr << e.what() << " in checkpoint file " << fname << endl;
+        throw err;
+    }
+
+    try {
+        if (ncount <= 0 || best_tour.size() != ncount)
+            throw runtime_error("Bad node count");
+
+        if (core_edges.size() % 2 != 0)
+            throw runtime_error("Odd core edge list");
+        for (int end : core_edges)
+            if (end < 0 || end >= ncount)
+                throw runtime_error("Bad core edge");
+
+        int nodecount = nodes.size();
+        int basecount = node_bases.size();
+
+        if (cur_node < 0 || cur_node >= nodecount)
+            throw runtime_error("Bad current node");
+
+        for (const Node &N : nodes) {
+            if (N.parent < -1 || N.parent >= nodecount ||
+                N.basis < -1 || N.basis >= basecount ||
+                N.stat < 0 ||
+                N.stat > static_cast<int>(BranchNode::Status::Done) ||
+                (N.direction != BranchNode::Dir::Down &&
+                 N.direction != BranchNode::Dir::Up))
+                throw runtime_error("Bad branch node");
+            if (N.parent == -1 ? N.depth != 0 :
+                N.depth != nodes[N.parent].depth + 1)
+                throw runtime_error("Bad branch node depth");
+        }
+    } catch (const exception &e) {
+        cerr << e.what() << " in checkpoint file " << fname << endl;
+        throw err;
+    }
+}
+
+/**
+ * The Checkpoint is written to a temporary file which is then renamed over
+ * \p fname, so a process killed while writing leaves the previous checkpoint
+ * intact.
+ */
+void Checkpoint::write(const string &fname) const
+{
+    runtime_error err("Problem in Checkpoint::write");
+
+    string tmp_fname = fname + ".tmp";
+
+    {
+        std::ofstream out(tmp_fname, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            cerr << "Couldn't open " << tmp_fname << " for writing" << endl;
+            throw err;
+        }
+
+        out.write(CkptMagic, sizeof(CkptMagic));
+        put(out, CkptVersion);
+
+        put_vec(out, vector<char>(probname.begin(), probname.end()));
+        put(out, seed);
+        put(out, ncount);
+
+        put_vec(out, core_edges);
+        put_vec(out, best_tour);
+        put(out, best_value);
+
+        put_vec(out, cuts.ref_tour);
+        put_vec(out, cuts.clique_beg);
+        put_vec(out, cuts.segs);
+        put_vec(out, cuts.clique_sorted);
+        put_vec(out, cuts.cut_beg);
+        put_vec(out, cuts.clique_refs);
+        put_vec(out, cuts.tooth_beg);
+        put_vec(out, cuts.tooth_refs);
+        put_vec(out, cuts.sense);
+        put_vec(out, cuts.rhs);
+        put_vec(out, cuts.ages);
+        put(out, cuts.lp_count);
+
+        put_vec(out, active_tour);
+        put(out, static_cast<char>(tourless));
+        put_basis(out, active_base);
+
+        put_vec(out, nodes);
+        put(out, static_cast<std::uint64_t>(node_bases.size()));
+        for (const LP::Basis &base : node_bases)
+            put_basis(out, base);
+        put(out, cur_node);
+
+        out.close();
+        if (!out) {
+            cerr << "Failed writing " << tmp_fname << endl;
+            std::remove(tmp_fname.c_str());
+            throw err;
+        }
+    }
+
+    if (std::rename(tmp_fname.c_str(), fname.c_str()) != 0) {
+        cerr << "Couldn't rename " << tmp_fname << " to " << fname << endl;
+        std::remove(tmp_fname.c_str());
+        throw err;
+    }
+}
+
+/**
+ * @param history the branch history of an ABC search.
+ * @param cur the node of \p history that will be examined next.
+ */
+void Checkpoint::set_history(const BranchHistory &history,
+                             const BranchNode &cur)
+{
+    runtime_error err("Problem in Checkpoint::set_history");
+
+    nodes.clear();
+    node_bases.clear();
+    cur_node = -1;
+
+    try {
+        std::unordered_map<const BranchNode *, int> index;
+        for (const BranchNode &B : history)
+            index.emplace(&B, index.size());
+
+        for (const BranchNode &B : history) {
+            Node N;
+            N.ends[0] = B.ends.end[0];
+            N.ends[1] = B.ends.end[1];
+            N.direction = B.direction;
+            N.stat = static_cast<int>(B.stat);
+            N.parent = B.is_root() ? -1 : index.at(B.parent);
+            N.depth = B.depth;
+            N.basis = -1;
+            N.tourlen = B.tourlen;
+            N.estimate = B.estimate;
+
+            if (!B.price_basis.empty()) {
+                N.basis = node_bases.size();
+                node_bases.push_back(B.price_basis.unpack());
+            }
+
+            if (&B == &cur)
+                cur_node = nodes.size();
+
+            nodes.push_back(N);
+        }
+    } CMR_CATCH_PRINT_THROW("copying branch nodes", err);
+
+    if (cur_node == -1)
+        throw runtime_error("Current node not in history");
+}
+
+/**
+ * @param[out] history an empty list, which is filled with the nodes of the
+ * saved branch history with their parent pointers set.
+ * @param[out] cur the node to be examined next.
+ */
+void Checkpoint::get_history(BranchHistory &history,
+                             BranchHistory::iterator &cur) const
+{
+    runtime_error err("Problem in Checkpoint::get_history");
+
+    vector<BranchNode *> node_ptrs;
+
+    try {
+        for (int i = 0; i < nodes.size(); ++i) {
+            history.emplace_back();
+            node_ptrs.push_back(&history.back());
+        }
+    } CMR_CATCH_PRINT_THROW("allocating nodes", err);
+
+    int i = 0;
+
+    for (auto it = history.begin(); it != history.end(); ++it, ++i) {
+        const Node &N = nodes[i];
+        BranchNode &B = *it;
+
+        B.ends = EndPts(N.ends[0], N.ends[1]);
+        B.direction = static_cast<BranchNode::Dir>(N.direction);
+        B.stat = static_cast<BranchNode::Status>(N.stat);
+        B.parent = N.parent == -1 ? nullptr : node_ptrs[N.parent];
+        B.depth = N.depth;
+        B.tourlen = N.tourlen;
+        B.estimate = N.estimate;
+
+        if (N.basis != -1)
+            try {
+                B.price_basis = LP::BasisDelta(node_bases[N.basis], nullptr);
+            } CMR_CATCH_PRINT_THROW("packing node basis", err);
+
+        if (i == cur_node)
+            cur = it;
+    }
+}
+
+}
+}
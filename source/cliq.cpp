@@ -72,7 +72,7 @@ try
         }
     }
 
-    std::sort(seglist.begin(), seglist.end(), std::greater<CMR::Segment>());
+    finalize(true);
 } catch (const exception &e) {
     cerr << e.what() << "\n";
     throw runtime_error("Clique CCtsp_lpclique constructor failed.");
@@ -104,6 +104,7 @@ Clique::Clique(int start, int end,
 
     if (range_agrees) {
         seglist.push_back(seg);
+        finalize(false);
         return;
     }
 
@@ -126,6 +127,8 @@ Clique::Clique(int start, int end,
 
         seglist.push_back(CMR::Segment(low, seg_nodes[k++]));
     }
+
+    finalize(false);
 } catch (const exception &e) {
     cerr << e.what() << "\n";
     throw runtime_error("Clique seg constructor failed.");
@@ -165,13 +168,71 @@ try
         seglist.push_back(CMR::Segment(low, perm[target_nodes[i++]]));
     }
 
-    if (!preserve_order)
-        std::sort(seglist.begin(), seglist.end(), std::greater<CMR::Segment>());
+    finalize(!preserve_order);
 } catch (const exception &e) {
     cerr << e.what() << "\n";
     throw runtime_error("Clique nodelist constructor failed.");
 }
 
+/**
+ * If \p canonical, the segments are sorted by start index and adjacent
+ * segments are merged. The node count, sorted flag, and hash are then
+ * computed from the final segment list.
+ */
+void Clique::finalize(bool canonical)
+{
+    if (canonical && !seglist.empty()) {
+        std::sort(seglist.begin(), seglist.end(),
+                  [](const Segment &a, const Segment &b)
+                  { return a.start < b.start; });
+
+        int last = 0;
+
+        for (int i = 1; i < seglist.size(); ++i)
+            if (seglist[i].start == seglist[last].end + 1)
+                seglist[last].end = seglist[i].end;
+            else
+                seglist[++last] = seglist[i];
+
+        seglist.resize(last + 1);
+    }
+
+    nodecount = 0;
+    sorted = true;
+
+    for (int i = 0; i < seglist.size(); ++i) {
+        nodecount += seglist[i].size();
+        if (i > 0 && seglist[i - 1].end >= seglist[i].start)
+            sorted = false;
+    }
+
+    hval = hash_segs(seglist.data(), seglist.data() + seglist.size());
+}
+
+/**
+ * Each Segment is mixed with the 64-bit finalizer from splitmix64 before
+ * being combined, so that segment lists differing in one endpoint or in
+ * the order of segments get unrelated hash values.
+ */
+std::size_t Clique::hash_segs(const Segment *first, const Segment *last)
+{
+    std::uint64_t val = 0;
+
+    for (; first != last; ++first) {
+        std::uint64_t x = (static_cast<std::uint64_t>(first->start) << 32) ^
+        static_cast<std::uint32_t>(first->end);
+
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        x ^= (x >> 31);
+
+        val = (val ^ x) * 0x100000001b3ULL + (val >> 29);
+    }
+
+    return static_cast<std::size_t>(val);
+}
+
 /**
  * @param[in] saved_tour the tour that was active when this Clique was
  * constructed.
@@ -211,17 +272,62 @@ Tooth::Tooth(const SimpleTooth &T,
     throw runtime_error("Tooth constructor failed.");
 }
 
+constexpr CliqueId CliqueBank::NoClique;
+
 CliqueBank::CliqueBank(const vector<int> &tour, const vector<int> &perm)
-try : saved_tour(tour), saved_perm(perm) {} catch (const exception &e) {
+try : saved_tour(tour), saved_perm(perm), live_count(0), dead_segs(0) {}
+catch (const exception &e) {
     throw runtime_error("CliqueBank constructor failed.");
 }
 
-Clique::Ptr CliqueBank::add_clique(const Clique &clq)
+/**
+ * If \p clq is already in the bank its reference count is incremented.
+ * Otherwise its segments are appended to the arena, in a free slot if there
+ * is one.
+ * @returns the id of \p clq in this bank.
+ */
+CliqueId CliqueBank::add_clique(const Clique &clq)
 {
-    if (bank.count(clq) == 0)
-        bank[clq] = std::make_shared<Clique>(clq);
+    std::size_t hval = clq.hash();
+    CliqueId id = NoClique;
+
+    auto range = id_index.equal_range(hval);
+    for (auto it = range.first; it != range.second; ++it)
+        if (same_segs(it->second, clq)) {
+            id = it->second;
+            break;
+        }
+
+    if (id != NoClique) {
+        ++slots[id].refs;
+        return id;
+    }
+
+    if (!free_ids.empty()) {
+        id = free_ids.back();
+        free_ids.pop_back();
+    } else {
+        if (slots.size() == NoClique)
+            throw runtime_error("CliqueBank ran out of CliqueIds");
+        id = slots.size();
+        slots.emplace_back();
+    }
+
+    Slot &slot = slots[id];
+    const vector<Segment> &segs = clq.seg_list();
+
+    slot.seg_begin = seg_arena.size();
+    slot.seg_count = segs.size();
+    slot.refs = 1;
+    slot.nodes = clq.node_count();
+    slot.sorted = clq.is_sorted();
+    slot.hash = hval;
+
+    seg_arena.insert(seg_arena.end(), segs.begin(), segs.end());
+    id_index.emplace(hval, id);
+    ++live_count;
 
-    return bank[clq];
+    return id;
 }
 
 /**
@@ -229,8 +335,8 @@ Clique::Ptr CliqueBank::add_clique(const Clique &clq)
  * from the CCtsp_lpclique \p cc_cliq, with \p tour as the tour active
  * when \p cc_cliq was obtained.
  */
-Clique::Ptr CliqueBank::add_clique(const CCtsp_lpclique &cc_clq,
-                                    const vector<int> &tour)
+CliqueId CliqueBank::add_clique(const CCtsp_lpclique &cc_clq,
+                                const vector<int> &tour)
 {
     return add_clique(Clique(cc_clq, saved_tour, saved_perm, tour));
 }
@@ -239,7 +345,7 @@ Clique::Ptr CliqueBank::add_clique(const CCtsp_lpclique &cc_clq,
  * Constructs a Clique in place and adds it to the bank, using the Clique
  * constructor taking start and end points.
  */
-Clique::Ptr CliqueBank::add_clique(int start, int end, const vector<int> &tour)
+CliqueId CliqueBank::add_clique(int start, int end, const vector<int> &tour)
 {
     return add_clique(Clique(start, end, saved_tour, saved_perm, tour));
 }
@@ -250,12 +356,12 @@ Clique::Ptr CliqueBank::add_clique(int start, int end, const vector<int> &tour)
  * @warning The elements of \p nodes are sorted by this function, but
  * unchanged otherwise.
  */
-Clique::Ptr CliqueBank::add_clique(const vector<int> &nodes)
+CliqueId CliqueBank::add_clique(const vector<int> &nodes)
 {
     return add_clique(Clique(nodes, saved_perm, false));
 }
 
-Clique::Ptr CliqueBank::add_tour_clique(const vector<int> &tour_nodes)
+CliqueId CliqueBank::add_tour_clique(const vector<int> &tour_nodes)
 {
     return add_clique(Clique(tour_nodes, saved_perm, true));
 }
@@ -264,46 +370,113 @@ Clique::Ptr CliqueBank::add_tour_clique(const vector<int> &tour_nodes)
  * Steals a Clique from a bank and puts it into this CliqueBank, decrementing
  * its use count in the bank it is moved from. The reference to the Clique
  * will now be owned by this bank.
- * @param[in/out] clq_ptr the value `*clq_ptr` is inserted into this bank.
- * Then \p clq_ptr will point to `*clq_ptr` as a value in this bank, rather
- * than \p from_bank.
- * @param[in/out] from_bank the source bank that \p clq_ptr is being taken
- * from. This function will call `from_bank.del_clique(clq_ptr)`, decrementing
+ * @param[in/out] id the Clique `from_bank.get_clique(id)` is inserted into
+ * this bank. Then \p id is set to its id in this bank.
+ * @param[in/out] from_bank the source bank that \p id is being taken
+ * from. This function will call `from_bank.del_clique(id)`, decrementing
  * its use count in \p from_bank, possibly removing it from \p from_bank
  * entirely.
  */
-void CliqueBank::steal_clique(Clique::Ptr &clq_ptr, CliqueBank &from_bank)
+void CliqueBank::steal_clique(CliqueId &id, CliqueBank &from_bank)
 {
-    if (!clq_ptr)
+    if (!from_bank.live(id))
         throw runtime_error("Called steal_clique on null Clique");
 
-    Clique::Ptr new_clq = add_clique(*clq_ptr);
-    from_bank.del_clique(clq_ptr);
-    clq_ptr = std::move(new_clq);
+    CliqueId new_id = add_clique(from_bank.get_clique(id));
+    from_bank.del_clique(id);
+    id = new_id;
 }
 
 /**
- * The Clique pointed to by \p clq_ptr will be nullified, thereby
- * decrementing the reference count of every other reference to it.
- * If its reference count in the CliqueBank drops to one, it will be
- * erased, decreasing the size of the CliqueBank.
+ * If the reference count of the Clique \p id drops to zero it will be
+ * erased, decreasing the size of the CliqueBank, and \p id may be handed out
+ * again by a later call to add_clique.
  */
-void CliqueBank::del_clique(Clique::Ptr &clq_ptr)
+void CliqueBank::del_clique(CliqueId id)
 {
-    if (!clq_ptr)
+    if (!live(id))
         return;
 
-    Clique &clq = *clq_ptr;
+    Slot &slot = slots[id];
 
-    CliqueBank::Itr find_it = bank.find(clq);
-
-    if (find_it == bank.end())
+    if (--slot.refs > 0)
         return;
 
-    clq_ptr.reset();
+    auto range = id_index.equal_range(slot.hash);
+    for (auto it = range.first; it != range.second; ++it)
+        if (it->second == id) {
+            id_index.erase(it);
+            break;
+        }
 
-    if (find_it->second.use_count() <= 1)
-        bank.erase(find_it);
+    dead_segs += slot.seg_count;
+    slot.seg_count = 0;
+    free_ids.push_back(id);
+    --live_count;
+
+    if (dead_segs > 1024 && 2 * dead_segs > seg_arena.size())
+        compact();
+}
+
+/**
+ * @returns the id of the Clique with the same segments as \p clq, or
+ * NoClique if there is none. The reference count is unchanged.
+ */
+CliqueId CliqueBank::find(const Clique &clq) const
+{
+    auto range = id_index.equal_range(clq.hash());
+
+    for (auto it = range.first; it != range.second; ++it)
+        if (same_segs(it->second, clq))
+            return it->second;
+
+    return NoClique;
+}
+
+/**
+ * @returns a vector of the literal nodes obtained by dereferencing ref_tour()
+ * for the ranges in the segment list of the Clique \p id.
+ */
+vector<int> CliqueBank::node_list(CliqueId id) const
+{
+    vector<int> result;
+
+    for (const CMR::Segment &seg : seg_list(id))
+        for (int k = seg.start; k <= seg.end; ++k)
+            result.push_back(saved_tour[k]);
+
+    return result;
+}
+
+bool CliqueBank::same_segs(CliqueId id, const Clique &clq) const
+{
+    const vector<Segment> &segs = clq.seg_list();
+    SegRange range = seg_list(id);
+
+    return range.size() == segs.size() &&
+    std::equal(range.begin(), range.end(), segs.begin());
+}
+
+/**
+ * Ids are unchanged, only the seg_begin of each live slot is moved so that
+ * seg_arena holds no segments of freed cliques.
+ */
+void CliqueBank::compact()
+{
+    vector<Segment> packed;
+    packed.reserve(seg_arena.size() - dead_segs);
+
+    for (Slot &slot : slots) {
+        if (slot.refs == 0)
+            continue;
+
+        auto first = seg_arena.begin() + slot.seg_begin;
+        slot.seg_begin = packed.size();
+        packed.insert(packed.end(), first, first + slot.seg_count);
+    }
+
+    seg_arena = std::move(packed);
+    dead_segs = 0;
 }
 
 ToothBank::ToothBank(const vector<int> &tour, const vector<int> &perm)
@@ -331,6 +504,20 @@ Tooth::Ptr ToothBank::add_tooth(const SimpleTooth &T, const vector<int> &tour)
     return bank[t];
 }
 
+/**
+ * @param[in] root the root Clique, in positions of the saved tour.
+ * @param[in] body the body Clique, in positions of the saved tour.
+ */
+Tooth::Ptr ToothBank::add_tooth(const Clique &root, const Clique &body)
+{
+    Tooth t(root, body);
+
+    if (bank.count(t) == 0)
+        bank[t] = std::make_shared<Tooth>(t);
+
+    return bank[t];
+}
+
 void ToothBank::del_tooth(Tooth::Ptr &T_ptr)
 {
     if (!T_ptr)
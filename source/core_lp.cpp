@@ -1,8 +1,10 @@
 #include "core_lp.hpp"
 #include "err_util.hpp"
 #include "util.hpp"
+#include "config.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <stdexcept>
@@ -65,6 +67,8 @@ CoreLP::CoreLP(Graph::CoreGraph &core_graph_,
 
     if (lp_edges != active_tour.edges())
         throw runtime_error("Mismatched lp solution vec.");
+
+    ext_cuts.index_core_edges(core_graph);
 } catch (const exception &e) {
     cerr << e.what() << "\n";
     throw runtime_error("Problem in CoreLP constructor.");
@@ -90,9 +94,8 @@ PivType CoreLP::primal_pivot()
         bas = basis_obj();
         nondegen_pivot(active_tourlen());
         get_x(lp_edges);
-        supp_data = Data::SupportGroup(core_graph.get_edges(),
-                                       lp_edges, dfs_island,
-                                       ncount);
+        supp_data.update(core_graph.get_edges(), lp_edges, dfs_island,
+                         ncount);
     } CMR_CATCH_PRINT_THROW("pivoting and setting x", err);
 
     ++num_nd_pivots;
@@ -399,6 +402,45 @@ void CoreLP::prune_slacks()
     reset_instate_active();
 }
 
+/**
+ * Set `rows[i] = row_fn(i)` for each entry of \p rows, in parallel if OMP is
+ * enabled. The rows are independent, and the get_row functions only read
+ * the CoreGraph, so this is the expensive part of adding a round of cuts.
+ */
+template <typename RowFn>
+static void compute_rows(vector<SparseRow> &rows, RowFn row_fn)
+{
+    int count = rows.size();
+    std::atomic<bool> caught_exception(false);
+
+#if CMR_USE_OMP
+    #pragma omp parallel for
+#endif
+    for (int i = 0; i < count; ++i) {
+        if (caught_exception)
+            continue;
+        try {
+            rows[i] = row_fn(i);
+        } catch (const exception &e) {
+#if CMR_USE_OMP
+            #pragma omp critical
+#endif
+            {
+                cerr << e.what() << " computing row " << i << "\n";
+                caught_exception = true;
+            }
+        }
+    }
+
+    if (caught_exception)
+        throw runtime_error("Problem in compute_rows");
+}
+
+/**
+ * Each of the add_cuts overloads computes all the rows for its queue, adds
+ * them to the Relaxation with one call through cut_batch, and only then
+ * records them in ext_cuts, in the same order.
+ */
 void CoreLP::add_cuts(Sep::LPcutList &cutq)
 {
     if (cutq.empty())
@@ -409,13 +451,28 @@ void CoreLP::add_cuts(Sep::LPcutList &cutq)
 
     const vector<int> &perm = active_tour.tour_perm();
     const vector<int> &tour = active_tour.nodes();
+
+    vector<const lpcut_in *> cut_ptrs;
+    vector<SparseRow> rows;
+
     try {
-        for (const lpcut_in *cur = cutq.begin(); cur; cur = cur->next) {
-            SparseRow R = Sep::get_row(*cur, perm, core_graph);
-            add_cut(R);
+        for (const lpcut_in *cur = cutq.begin(); cur; cur = cur->next)
+            cut_ptrs.push_back(cur);
+        rows.resize(cut_ptrs.size());
+
+        compute_rows(rows, [&](int i)
+                     { return Sep::get_row(*cut_ptrs[i], perm, core_graph); });
+    } CMR_CATCH_PRINT_THROW("processing cuts", err);
+
+    try {
+        cut_batch.clear();
+        for (const SparseRow &R : rows)
+            cut_batch.push_back(R);
+        Relaxation::add_cuts(cut_batch);
+
+        for (const lpcut_in *cur : cut_ptrs)
             ext_cuts.add_cut(*cur, tour);
-        }
-    } CMR_CATCH_PRINT_THROW("processing/adding cut", err);
+    } CMR_CATCH_PRINT_THROW("adding cuts", err);
 
     cutq.clear();
 }
@@ -427,20 +484,38 @@ void CoreLP::add_cuts(Sep::CutQueue<Sep::dominoparity> &dpq)
 
     const vector<int> &tour_nodes = active_tour.nodes();
 
+    vector<const Sep::dominoparity *> dp_ptrs;
+    vector<SparseRow> rows;
+
     try {
-        while(!dpq.empty()) {
-            const Sep::dominoparity &dp_cut = dpq.peek_front();
-            SparseRow R = Sep::get_row(dp_cut, tour_nodes, core_graph);
-
-            // This should be investigated later but sometimes extremely
-            // dense cuts are returned, so this is a bad hacky workaround.
-            if (R.rmatind.size() < core_graph.edge_count() / 4) {
-                add_cut(R);
-                ext_cuts.add_cut(dp_cut, R.rhs, tour_nodes);
-            }
-            dpq.pop_front();
-        }
-    } CMR_CATCH_PRINT_THROW("processing/adding cut", err);
+        for (const Sep::dominoparity &dp_cut : dpq)
+            dp_ptrs.push_back(&dp_cut);
+        rows.resize(dp_ptrs.size());
+
+        compute_rows(rows, [&](int i)
+                     { return Sep::get_row(*dp_ptrs[i], tour_nodes,
+                                           core_graph); });
+    } CMR_CATCH_PRINT_THROW("processing cuts", err);
+
+    // This should be investigated later but sometimes extremely
+    // dense cuts are returned, so this is a bad hacky workaround.
+    auto too_dense = [this](const SparseRow &R)
+    { return R.rmatind.size() >= core_graph.edge_count() / 4; };
+
+    try {
+        cut_batch.clear();
+        for (const SparseRow &R : rows)
+            if (!too_dense(R))
+                cut_batch.push_back(R);
+        Relaxation::add_cuts(cut_batch);
+
+        for (int i = 0; i < rows.size(); ++i)
+            if (!too_dense(rows[i]))
+                ext_cuts.add_cut(*dp_ptrs[i], rows[i].rhs, tour_nodes);
+    } CMR_CATCH_PRINT_THROW("adding cuts", err);
+
+    while (!dpq.empty())
+        dpq.pop_front();
 }
 
 void CoreLP::add_cuts(Sep::CutQueue<SparseRow> &gmi_q)
@@ -449,12 +524,16 @@ void CoreLP::add_cuts(Sep::CutQueue<SparseRow> &gmi_q)
     prev_numrows = num_rows();
 
     try {
+        cut_batch.clear();
+        for (const SparseRow &R : gmi_q)
+            cut_batch.push_back(R);
+        Relaxation::add_cuts(cut_batch);
+
         while (!gmi_q.empty()) {
-            add_cut(gmi_q.peek_front());
             ext_cuts.add_cut();
             gmi_q.pop_front();
         }
-    } CMR_CATCH_PRINT_THROW("adding sparse cut row", err);
+    } CMR_CATCH_PRINT_THROW("adding sparse cut rows", err);
 }
 
 void CoreLP::add_cuts(Sep::CutQueue<Sep::ex_blossom> &ex2m_q)
@@ -465,20 +544,28 @@ void CoreLP::add_cuts(Sep::CutQueue<Sep::ex_blossom> &ex2m_q)
     int ncount = core_graph.node_count();
 
     const vector<double> &tour_edges = active_tour.edges();
+    const vector<Graph::Edge> &edges = core_graph.get_edges();
 
-    try {
-        while (!ex2m_q.empty()) {
-            const Sep::ex_blossom &B = ex2m_q.peek_front();
-            const vector<int> &handle_nodes = B.handle;
-            const vector<Graph::Edge> &edges = core_graph.get_edges();
+    vector<const Sep::ex_blossom *> blossoms;
+    vector<vector<vector<int>>> all_tooth_edges;
+    vector<SparseRow> rows;
 
-            vector<int> handle_delta  = Graph::delta_inds(handle_nodes, edges,
+    try {
+        for (const Sep::ex_blossom &B : ex2m_q)
+            blossoms.push_back(&B);
+        rows.resize(blossoms.size());
+        all_tooth_edges.resize(blossoms.size());
+
+        compute_rows(rows, [&](int i)
+        {
+            const Sep::ex_blossom &B = *blossoms[i];
+            vector<int> handle_delta  = Graph::delta_inds(B.handle, edges,
                                                           ncount);
             vector<int> tooth_inds = Sep::teeth_inds(B,
                                                      tour_edges, lp_edges,
                                                      edges, ncount,
                                                      handle_delta);
-            vector<vector<int>> tooth_edges;
+            vector<vector<int>> &tooth_edges = all_tooth_edges[i];
             tooth_edges.reserve(tooth_inds.size());
 
             for (int ind : tooth_inds) {
@@ -486,12 +573,22 @@ void CoreLP::add_cuts(Sep::CutQueue<Sep::ex_blossom> &ex2m_q)
                 tooth_edges.emplace_back(vector<int>{e.end[0], e.end[1]});
             }
 
-            SparseRow R = Sep::get_row(handle_delta, tooth_edges, core_graph);
-            add_cut(R);
-            ext_cuts.add_cut(handle_nodes, tooth_edges);
-            ex2m_q.pop_front();
-        }
-    } CMR_CATCH_PRINT_THROW("processing/adding cuts", err);
+            return Sep::get_row(handle_delta, tooth_edges, core_graph);
+        });
+    } CMR_CATCH_PRINT_THROW("processing cuts", err);
+
+    try {
+        cut_batch.clear();
+        for (const SparseRow &R : rows)
+            cut_batch.push_back(R);
+        Relaxation::add_cuts(cut_batch);
+
+        for (int i = 0; i < blossoms.size(); ++i)
+            ext_cuts.add_cut(blossoms[i]->handle, all_tooth_edges[i]);
+    } CMR_CATCH_PRINT_THROW("adding cuts", err);
+
+    while (!ex2m_q.empty())
+        ex2m_q.pop_front();
 }
 
 void CoreLP::add_cuts(Sep::CutQueue<Sep::HyperGraph> &pool_q)
@@ -499,16 +596,26 @@ void CoreLP::add_cuts(Sep::CutQueue<Sep::HyperGraph> &pool_q)
     runtime_error err("Problem in CoreLP::add_cuts(Sep::HyperGraph)");
     prev_numrows = num_rows();
 
+    vector<const Sep::HyperGraph *> pool_cuts;
+    vector<SparseRow> rows;
+    vector<int> end_pos;
+
+    try {
+        for (const Sep::HyperGraph &H : pool_q)
+            pool_cuts.push_back(&H);
+
+        Sep::HyperGraph::get_coeffs(core_graph.get_edges(), pool_cuts, rows,
+                                    end_pos);
+    } CMR_CATCH_PRINT_THROW("getting pool cut rows", err);
+
     try {
+        cut_batch.clear();
+        for (const SparseRow &R : rows)
+            cut_batch.push_back(R);
+        Relaxation::add_cuts(cut_batch);
+
         while (!pool_q.empty()) {
-            Sep::HyperGraph &H = pool_q.peek_front();
-            SparseRow R;
-
-            R.sense = H.get_sense();
-            R.rhs = H.get_rhs();
-            H.get_coeffs(core_graph.get_edges(), R.rmatind, R.rmatval);
-            add_cut(R);
-            ext_cuts.add_cut(H);
+            ext_cuts.add_cut(pool_q.peek_front());
             pool_q.pop_front();
         }
     } CMR_CATCH_PRINT_THROW("processing/adding cuts", err);
@@ -534,20 +641,23 @@ void CoreLP::add_edges(const vector<Graph::Edge> &batch, bool reinstate)
     try {
         for (const Graph::Edge &e : batch)
             core_graph.add_edge(e);
+        ext_cuts.core_edges_added(old_ecount);
     } CMR_CATCH_PRINT_THROW("adding edges to core graph/best group", err);
 
-    double lb = 0.0;
-    double ub = 1.0;
+    vector<double> objval;
+    vector<double> lb(batch.size(), 0.0);
+    vector<double> ub(batch.size(), 1.0);
+    vector<int> cmatbeg;
     vector<int> cmatind;
     vector<double> cmatval;
 
     try {
-        for (const Graph::Edge &e : batch) {
-            double objval = e.len;
+        objval.reserve(batch.size());
+        for (const Graph::Edge &e : batch)
+            objval.push_back(e.len);
 
-            ext_cuts.get_col(e.end[0], e.end[1], cmatind, cmatval);
-            add_col(objval, cmatind, cmatval, lb, ub);
-        }
+        ext_cuts.get_cols(batch, cmatbeg, cmatind, cmatval);
+        add_cols(objval, cmatbeg, cmatind, cmatval, lb, ub);
         lp_edges.resize(new_ecount, 0.0);
         best_data.best_tour_edges.resize(new_ecount, 0);
     } CMR_CATCH_PRINT_THROW("adding edges to core lp/resizing", err);
@@ -586,6 +696,7 @@ void CoreLP::remove_edges(vector<int> edge_delstat, bool reinstate)
 
     try {
         core_graph.remove_edges();
+        ext_cuts.core_edges_removed(delstat);
     } CMR_CATCH_PRINT_THROW("removing edges from coregraph", err);
 
     lp_edges.resize(core_graph.edge_count());
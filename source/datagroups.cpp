@@ -66,6 +66,8 @@ try : random_seed(seed) {
     pname = fname.substr(fname.find_last_of("/") + 1);
     pname = pname.substr(0, pname.find_last_of("."));
 
+    set_len_kernel();
+
     cout << std::fixed;
 
 } catch (const exception &e) {
@@ -105,6 +107,8 @@ try : nodecount(ncount), random_seed(seed),
 		    &tmp_ncount, ptr(), tmp_gridsize, allow_dups, &rstate))
     throw runtime_error("CCutil_getdata failed.");
 
+  set_len_kernel();
+
   cout << std::fixed;
 
 
@@ -144,7 +148,8 @@ try
 }
 
 Instance::Instance(Instance &&I) noexcept :
-    nodecount(I.nodecount), random_seed(I.random_seed), pname(I.pname)
+    nodecount(I.nodecount), random_seed(I.random_seed), pname(I.pname),
+    len_kernel(I.len_kernel)
 {
     CCutil_freedatagroup(&dat);
     dat = I.dat;
@@ -153,6 +158,7 @@ Instance::Instance(Instance &&I) noexcept :
     I.nodecount = 0;
     I.random_seed = 0;
     I.pname.clear();
+    I.len_kernel = LenKernel::Generic;
 }
 
 Instance& Instance::operator=(Instance &&I) noexcept
@@ -160,6 +166,7 @@ Instance& Instance::operator=(Instance &&I) noexcept
   nodecount = I.nodecount;
   random_seed = I.random_seed;
   pname = I.pname;
+  len_kernel = I.len_kernel;
 
   CCutil_freedatagroup(&dat);
   dat = I.dat;
@@ -168,12 +175,45 @@ Instance& Instance::operator=(Instance &&I) noexcept
   I.nodecount = 0;
   I.random_seed = 0;
   I.pname.clear();
+  I.len_kernel = LenKernel::Generic;
 
   return *this;
 }
 
 Instance::~Instance() { CCutil_freedatagroup(&dat); }
 
+/**
+ * The batch kernels of edgelens are used only if the instance has no depots
+ * and every coordinate is an integer of absolute value at most 2^25. Then
+ * all squared distances are integers below 2^53, so they are computed
+ * exactly regardless of evaluation order or FMA contraction.
+ */
+void Instance::set_len_kernel()
+{
+    constexpr double CoordMax = 33554432.0; // 2^25
+
+    len_kernel = LenKernel::Generic;
+
+    if (dat.ndepot != 0 || dat.x == nullptr || dat.y == nullptr)
+        return;
+
+    LenKernel candidate;
+
+    if (dat.norm == CC_EUCLIDEAN)
+        candidate = LenKernel::Euclid;
+    else if (dat.norm == CC_ATT)
+        candidate = LenKernel::Att;
+    else
+        return;
+
+    for (int i = 0; i < nodecount; ++i)
+        for (double c : {dat.x[i], dat.y[i]})
+            if (c != std::floor(c) || std::fabs(c) > CoordMax)
+                return;
+
+    len_kernel = candidate;
+}
+
 double Instance::tour_length(const vector<int> &tour_nodes) const
 {
     if (tour_nodes.size() != nodecount) {
@@ -452,19 +492,44 @@ BestGroup::BestGroup(const Instance &inst, Graph::CoreGraph &core_graph) try :
     throw runtime_error("BestGroup LK constructor failed.");
 }
 
+/// The tour nodes in \p tourfile, for an instance with \p ncount nodes.
+static vector<int> file_tour(int ncount, const std::string &tourfile)
+{
+    vector<int> tour_nodes(ncount);
+    util::get_tour_nodes(ncount, tour_nodes, tourfile);
+    return tour_nodes;
+}
+
 BestGroup::BestGroup(const Instance &inst, Graph::CoreGraph &core_graph,
                      const std::string &tourfile) try :
+    BestGroup(inst, core_graph, file_tour(core_graph.node_count(), tourfile))
+{} catch (const exception &e) {
+    cerr << e.what() << "\n";
+    throw runtime_error("BestGroup file constructor failed.");
+}
+
+/**
+ * Edges of the tour missing from \p core_graph are added to it, along with
+ * the extra edge needed for a Padberg-Hong basis if the node count is even.
+ */
+BestGroup::BestGroup(const Instance &inst, Graph::CoreGraph &core_graph,
+                     vector<int> tour_nodes) try :
     best_tour_edges(std::vector<int>(core_graph.edge_count(), 0)),
-    best_tour_nodes(std::vector<int>(core_graph.node_count())),
-    perm(best_tour_nodes.size()),
+    best_tour_nodes(std::move(tour_nodes)),
+    perm(best_tour_nodes.size(), -1),
     min_tour_value(DoubleMax)
 {
     int ncount = core_graph.node_count();
 
-    util::get_tour_nodes(ncount, best_tour_nodes, tourfile);
+    if (best_tour_nodes.size() != ncount)
+        throw runtime_error("Tour has wrong node count");
 
-    for (int i = 0; i < best_tour_nodes.size(); ++i)
-        perm[best_tour_nodes[i]] = i;
+    for (int i = 0; i < best_tour_nodes.size(); ++i) {
+        int n = best_tour_nodes[i];
+        if (n < 0 || n >= ncount || perm[n] != -1)
+            throw runtime_error("Tour is not a permutation");
+        perm[n] = i;
+    }
 
     for (int i = 0; i < ncount; ++i) {
         int e0 = best_tour_nodes[i];
@@ -506,7 +571,7 @@ BestGroup::BestGroup(const Instance &inst, Graph::CoreGraph &core_graph,
     cout << "Loaded and verified tour with length " << min_tour_value << endl;
 } catch (const exception &e) {
     cerr << e.what() << "\n";
-    throw runtime_error("BestGroup file constructor failed.");
+    throw runtime_error("BestGroup tour constructor failed.");
 }
 
 /**
@@ -548,6 +613,7 @@ try : lp_vec(lp_x)
 
 SupportGroup::SupportGroup(SupportGroup &&SG) noexcept
     : lp_vec(std::move(SG.lp_vec)),
+      changed_edges(std::move(SG.changed_edges)),
       support_indices(std::move(SG.support_indices)),
       support_elist(std::move(SG.support_elist)),
       support_ecap(std::move(SG.support_ecap)),
@@ -559,6 +625,7 @@ SupportGroup::SupportGroup(SupportGroup &&SG) noexcept
 SupportGroup &SupportGroup::operator=(SupportGroup &&SG) noexcept
 {
     lp_vec = std::move(SG.lp_vec);
+    changed_edges = std::move(SG.changed_edges);
     support_indices = std::move(SG.support_indices);
     support_elist = std::move(SG.support_elist);
     support_ecap = std::move(SG.support_ecap);
@@ -569,6 +636,177 @@ SupportGroup &SupportGroup::operator=(SupportGroup &&SG) noexcept
     return *this;
 }
 
+/// Find the root of \p x in a union-find forest, halving paths as we go.
+static int uf_find(vector<int> &parent, int x)
+{
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+/// Remove the AdjObj with edge index \p index from the neighbors of \p n.
+static void remove_adj(Graph::Node &n, int index)
+{
+    vector<Graph::AdjObj> &nbrs = n.neighbors;
+    for (int k = 0; k < nbrs.size(); ++k)
+        if (nbrs[k].edge_index == index) {
+            nbrs[k] = nbrs.back();
+            nbrs.pop_back();
+            return;
+        }
+}
+
+/// Set the val of the AdjObj with edge index \p index in \p n to \p val.
+static void set_adj_val(Graph::Node &n, int index, double val)
+{
+    for (Graph::AdjObj &a : n.neighbors)
+        if (a.edge_index == index) {
+            a.val = val;
+            return;
+        }
+}
+
+/**
+ * Only the entries of \p lp_x that differ from lp_vec are touched in the
+ * support graph, and their indices are recorded in changed_edges.
+ * Connectivity is known without search if the graph was connected and no
+ * edge left the support; otherwise it is found by union-find. If the
+ * edge set does not match the one used for the current support, this falls
+ * back to constructing the SupportGroup from scratch, and changed_edges
+ * then holds all the support indices.
+ * @param edges the edge set for the new solution.
+ * @param lp_x the new LP solution, indexed by \p edges.
+ * @param island if the new solution is connected and integral, this is
+ * the tour it describes in DFS order from node 0. Otherwise it holds the
+ * nodes in the component of node 0.
+ * @param ncount the number of nodes.
+ */
+void SupportGroup::update(const vector<Graph::Edge> &edges,
+                          const vector<double> &lp_x,
+                          vector<int> &island,
+                          int ncount)
+{
+    runtime_error err("Problem in SupportGroup::update");
+
+    bool same_edges = (lp_vec.size() == lp_x.size() &&
+                       supp_graph.node_count == ncount &&
+                       !lp_vec.empty());
+
+    for (int k = 0; same_edges && k < support_indices.size(); ++k) {
+        const Graph::Edge &e = edges[support_indices[k]];
+        if (support_elist[2 * k] != e.end[0] ||
+            support_elist[(2 * k) + 1] != e.end[1])
+            same_edges = false;
+    }
+
+    if (!same_edges) {
+        try {
+            *this = SupportGroup(edges, lp_x, island, ncount);
+            changed_edges = support_indices;
+        } CMR_CATCH_PRINT_THROW("rebuilding support", err);
+        return;
+    }
+
+    bool was_connected = connected;
+    bool lost_edge = false;
+
+    try {
+        changed_edges.clear();
+
+        for (int i = 0; i < lp_x.size(); ++i) {
+            double old_val = lp_vec[i];
+            double new_val = lp_x[i];
+            if (old_val == new_val)
+                continue;
+
+            changed_edges.push_back(i);
+            lp_vec[i] = new_val;
+
+            bool in_old = old_val >= Eps::Zero;
+            bool in_new = new_val >= Eps::Zero;
+            const Graph::Edge &e = edges[i];
+            Graph::Node &n0 = supp_graph.nodelist[e.end[0]];
+            Graph::Node &n1 = supp_graph.nodelist[e.end[1]];
+
+            if (in_old && in_new) {
+                set_adj_val(n0, i, new_val);
+                set_adj_val(n1, i, new_val);
+            } else if (in_new) {
+                n0.neighbors.emplace_back(e.end[1], i, new_val);
+                n1.neighbors.emplace_back(e.end[0], i, new_val);
+                ++supp_graph.edge_count;
+            } else if (in_old) {
+                remove_adj(n0, i);
+                remove_adj(n1, i);
+                --supp_graph.edge_count;
+                lost_edge = true;
+            }
+        }
+    } CMR_CATCH_PRINT_THROW("diffing lp solutions", err);
+
+    if (!changed_edges.empty()) {
+        try {
+            integral = true;
+            support_indices.clear();
+            support_ecap.clear();
+            support_elist.clear();
+
+            for (int i = 0; i < lp_vec.size(); ++i)
+                if (lp_vec[i] >= Eps::Zero) {
+                    support_indices.push_back(i);
+                    support_ecap.push_back(lp_vec[i]);
+                    support_elist.push_back(edges[i].end[0]);
+                    support_elist.push_back(edges[i].end[1]);
+
+                    if (lp_vec[i] <= 1 - Eps::Zero)
+                        integral = false;
+                }
+        } CMR_CATCH_PRINT_THROW("rebuilding support vectors", err);
+    }
+
+    vector<int> uf_parent;
+
+    if (was_connected && !lost_edge) {
+        connected = true;
+    } else {
+        try {
+            uf_parent.resize(ncount);
+            for (int i = 0; i < ncount; ++i)
+                uf_parent[i] = i;
+        } CMR_CATCH_PRINT_THROW("allocating union-find", err);
+
+        int components = ncount;
+        for (int k = 0; k < support_indices.size(); ++k) {
+            int r0 = uf_find(uf_parent, support_elist[2 * k]);
+            int r1 = uf_find(uf_parent, support_elist[(2 * k) + 1]);
+            if (r0 != r1) {
+                uf_parent[r0] = r1;
+                --components;
+            }
+        }
+
+        connected = (components == 1);
+    }
+
+    try {
+        if (connected && integral) {
+            supp_graph.connected(island, 0);
+        } else if (connected) {
+            island.resize(ncount);
+            for (int i = 0; i < ncount; ++i)
+                island[i] = i;
+        } else {
+            island.clear();
+            int root = uf_find(uf_parent, 0);
+            for (int i = 0; i < ncount; ++i)
+                if (uf_find(uf_parent, i) == root)
+                    island.push_back(i);
+        }
+    } CMR_CATCH_PRINT_THROW("setting island", err);
+}
+
 bool SupportGroup::in_subtour_poly()
 {
     if (!connected)
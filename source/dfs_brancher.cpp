@@ -60,6 +60,12 @@ void DFSbrancher::enqueue_split(BranchNode::Split prob_array)
 }
 
 
+/**
+ * Nothing is needed, since fetch_next finds the first unvisited node in the
+ * order of branch_history, which is preserved by BaseBrancher::resume.
+ */
+void DFSbrancher::rebuild_queue(BranchHistory::iterator cur) {}
+
 BranchHistory::iterator DFSbrancher::next_prob()
 {
     if (verbose)
@@ -128,6 +128,13 @@ BranchNode::Split Executor::split_problem(ScoreTuple &branch_tuple,
 
 
     BranchNode::Split result;
+    LP::PackedBasis::Ptr parent_base;
+
+    try {
+        if (branch_tuple.down_est.sb_base || branch_tuple.up_est.sb_base)
+            parent_base = std::make_shared<const LP::PackedBasis>(
+                active_tour.base());
+    } CMR_CATCH_PRINT_THROW("packing parent basis", err);
 
     for (int i : {0, 1}) {
         edge_stats.emplace_back(EndsDir(branch_edge, dir_from_int(i)));
@@ -150,7 +157,12 @@ BranchNode::Split Executor::split_problem(ScoreTuple &branch_tuple,
             result[i].stat = BranchNode::Status::Pruned;
         else {
             if (estat != EstStat::Abort || estval > best_data.min_tour_value) {
-                result[i].price_basis = std::move(est.sb_base);
+                if (est.sb_base)
+                    try {
+                        result[i].price_basis = LP::BasisDelta(*est.sb_base,
+                                                               parent_base);
+                        est.sb_base.reset();
+                    } CMR_CATCH_PRINT_THROW("packing child basis", err);
                 if (estat == EstStat::Infeas)
                     result[i].stat = BranchNode::Status::NeedsRecover;
                 else
@@ -3,13 +3,24 @@
 #include "util.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <stdexcept>
+#include <string>
 #include <utility>
 
+#include <cerrno>
 #include <cmath>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 extern "C" {
 #include <concorde/INCLUDE/cuttree.h>
 }
@@ -17,6 +28,7 @@ extern "C" {
 using std::unordered_map;
 using std::vector;
 using std::pair;
+using std::string;
 
 using std::cout;
 using std::cerr;
@@ -37,7 +49,7 @@ namespace Sep {
 
 /**
  * The cut corresponding to \p cc_lpcut will be represented using
- * Clique pointers from \p bank, assuming that the cut was found with
+ * Clique ids from \p bank, assuming that the cut was found with
  * \p tour as the resident best tour.
  */
 HyperGraph::HyperGraph(CliqueBank &bank, const lpcut_in &cc_lpcut,
@@ -58,7 +70,7 @@ HyperGraph::HyperGraph(CliqueBank &bank, const lpcut_in &cc_lpcut,
 
 /**
  * The cut corresponding to \p dp_cut will be represented using Clique
- * pointers from \p bank and Tooth pointers from \p tbank, assuming the cut
+ * ids from \p bank and Tooth pointers from \p tbank, assuming the cut
  * was found with \p tour as the resident best tour. The righthand side of the
  * cut stored shall be \p _rhs.
  */
@@ -162,8 +174,8 @@ void HyperGraph::transfer_source(CliqueBank &new_source_bank) try
     if (cut_type() == Type::Non || cut_type() == Type::Branch)
         throw runtime_error("Tried to transfer_source on Non cut");
 
-    for (Clique::Ptr &clq_ptr : cliques)
-        new_source_bank.steal_clique(clq_ptr, *source_bank);
+    for (CliqueId &id : cliques)
+        new_source_bank.steal_clique(id, *source_bank);
 
     source_bank = &new_source_bank;
 } catch (const exception &e) {
@@ -202,12 +214,10 @@ CCtsp_lpcut_in HyperGraph::to_lpcut_in(const vector<int> &active_perm,
     if ((rval = CCtsp_create_lpcliques(&result, num_cliques)))
         throw err;
 
-    const vector<int> &def_tour = source_bank->ref_tour();
     for (int i = 0; i < num_cliques; ++i) {
-        const Clique::Ptr &clq_ref = cliques[i];
         vector<int> clq_nodes;
 
-        try { clq_nodes = clq_ref->node_list(def_tour); }
+        try { clq_nodes = source_bank->node_list(cliques[i]); }
         catch (const exception &e) {
             rval = 1;
             cerr << e.what() << " getting clique nodes" << endl;
@@ -235,8 +245,8 @@ CCtsp_lpcut_in HyperGraph::to_lpcut_in(const vector<int> &active_perm,
 HyperGraph::~HyperGraph()
 {
     if (source_bank != nullptr)
-        for (Clique::Ptr &ref : cliques)
-            source_bank->del_clique(ref);
+        for (CliqueId id : cliques)
+            source_bank->del_clique(id);
 
     if (source_toothbank != nullptr)
         for (Tooth::Ptr &ref : teeth)
@@ -272,9 +282,9 @@ double HyperGraph::get_coeff(int end0, int end1) const
         int end0_ind = perm[end0];
         int end1_ind = perm[end1];
 
-        for (const Clique::Ptr &clq_ref : cliques) {
-            bool contains_end0 = clq_ref->contains(end0_ind);
-            bool contains_end1 = clq_ref->contains(end1_ind);
+        for (CliqueId id : cliques) {
+            bool contains_end0 = source_bank->contains(id, end0_ind);
+            bool contains_end1 = source_bank->contains(id, end1_ind);
 
             if (contains_end0 != contains_end1)
                 result += 1.0;
@@ -290,10 +300,10 @@ double HyperGraph::get_coeff(int end0, int end1) const
     int end0_ind = handle_perm[end0];
     int end1_ind = handle_perm[end1];
 
-    const Clique::Ptr &handle_clq = cliques[0];
+    CliqueId handle_clq = cliques[0];
 
-    bool contains_end0 = handle_clq->contains(end0_ind);
-    bool contains_end1 = handle_clq->contains(end1_ind);
+    bool contains_end0 = source_bank->contains(handle_clq, end0_ind);
+    bool contains_end1 = source_bank->contains(handle_clq, end1_ind);
 
     if (contains_end0 && contains_end1) //in E(H)
         pre_result += 2;
@@ -337,9 +347,95 @@ double HyperGraph::get_coeff(int end0, int end1) const
     return static_cast<double>(pre_result);
 }
 
+/**
+ * This is the kernel behind both get_coeffs methods. Each edge is handled
+ * once, testing its end positions against the segments of each Clique and
+ * Tooth, so no node marks or coefficient maps are needed.
+ * @param[in] end_pos tour positions of edge endpoints, as computed by
+ * tour_positions. Teeth are dereferenced with the same positions as cliques,
+ * since the CliqueBank and ToothBank of a cut share a reference tour.
+ * @param[out] rmatind the indices of edges with nonzero coefficients, in
+ * increasing order.
+ * @param[out] rmatval the coefficients corresponding to \p rmatind.
+ */
+void HyperGraph::pos_coeffs(const vector<int> &end_pos, vector<int> &rmatind,
+                            vector<double> &rmatval) const
+{
+    if (cut_type() == Type::Non)
+        throw runtime_error("Tried HyperGraph::pos_coeffs on Non cut.");
+
+    rmatind.clear();
+    rmatval.clear();
+
+    int ecount = end_pos.size() / 2;
+
+    const CliqueBank &bank = *source_bank;
+
+    if (cut_type() != Type::Domino) {
+        for (int i = 0; i < ecount; ++i) {
+            int pos0 = end_pos[2 * i];
+            int pos1 = end_pos[2 * i + 1];
+            int coeff = 0;
+
+            for (CliqueId id : cliques)
+                if (bank.contains(id, pos0) != bank.contains(id, pos1))
+                    ++coeff;
+
+            if (coeff != 0) {
+                rmatind.push_back(i);
+                rmatval.push_back(coeff);
+            }
+        }
+
+        return;
+    } //else it is a domino cut
+
+    CliqueId handle = cliques[0];
+
+    for (int i = 0; i < ecount; ++i) {
+        int pos0 = end_pos[2 * i];
+        int pos1 = end_pos[2 * i + 1];
+        int pre_coeff = 0;
+
+        bool h0 = bank.contains(handle, pos0);
+        bool h1 = bank.contains(handle, pos1);
+
+        if (h0 && h1)
+            pre_coeff += 2;
+        else if (h0 != h1)
+            pre_coeff += 1;
+
+        for (const Tooth::Ptr &t_ref : teeth) {
+            const Clique &root_clq = t_ref->set_pair()[0];
+            const Clique &bod_clq = t_ref->set_pair()[1];
+
+            bool bod0 = bod_clq.contains(pos0);
+            bool bod1 = bod_clq.contains(pos1);
+
+            if (bod0 && bod1)
+                pre_coeff += 2;
+            else if (bod0) {
+                if (root_clq.contains(pos1))
+                    pre_coeff += 1;
+            } else if (bod1) {
+                if (root_clq.contains(pos0))
+                    pre_coeff += 1;
+            }
+        }
+
+        pre_coeff /= 2;
+
+        if (pre_coeff != 0) {
+            rmatind.push_back(i);
+            rmatval.push_back(pre_coeff);
+        }
+    }
+}
+
 ExternalCuts::ExternalCuts(const vector<int> &tour, const vector<int> &perm)
 try : node_count(tour.size()), clique_bank(tour, perm), tooth_bank(tour, perm),
-      pool_cliques(tour, perm)
+      pool_cliques(tour, perm), revision(0), index_graph(nullptr),
+      indexed_ecount(0), index_marks(tour.size(), 0), index_marker(0)
 {
     int ncount = node_count;
     if (CCtsp_init_cutpool(&ncount, NULL, &cc_pool))
@@ -370,6 +466,8 @@ void ExternalCuts::add_cut(const lpcut_in &cc_lpcut,
                            const vector<int> &current_tour)
 {
     cuts.emplace_back(clique_bank, cc_lpcut, current_tour);
+    ++revision;
+    index_cut(cuts.back());
 }
 
 /**
@@ -381,6 +479,8 @@ void ExternalCuts::add_cut(const dominoparity &dp_cut, const double rhs,
                            const vector<int> &current_tour)
 {
     cuts.emplace_back(clique_bank, tooth_bank, dp_cut, rhs, current_tour);
+    ++revision;
+    index_cut(cuts.back());
 }
 
 /**
@@ -392,6 +492,8 @@ void ExternalCuts::add_cut(const vector<int> &blossom_handle,
                            const vector<vector<int>> &tooth_edges)
 {
     cuts.emplace_back(clique_bank, blossom_handle, tooth_edges);
+    ++revision;
+    index_cut(cuts.back());
 }
 
 /**
@@ -403,6 +505,8 @@ void ExternalCuts::add_cut(HyperGraph &H)
 {
     H.transfer_source(clique_bank);
     cuts.emplace_back(std::move(H));
+    ++revision;
+    index_cut(cuts.back());
 }
 
 /**
@@ -410,7 +514,11 @@ void ExternalCuts::add_cut(HyperGraph &H)
  * indexing that agrees with the Relaxation for bookkeeping and cut pruning
  * purposes.
  */
-void ExternalCuts::add_cut() { cuts.emplace_back(); }
+void ExternalCuts::add_cut()
+{
+    cuts.emplace_back();
+    ++revision;
+}
 
 void ExternalCuts::reset_ages()
 {
@@ -463,6 +571,13 @@ void ExternalCuts::del_cuts(vector<int> &delset)
 
     util::erase_remove(cuts, [](const HyperGraph &H)
                        { return H.sense == 'X'; });
+    ++revision;
+
+    for (auto it = clique_edge_index.begin(); it != clique_edge_index.end();)
+        if (!clique_bank.live(it->first))
+            it = clique_edge_index.erase(it);
+        else
+            ++it;
 }
 
 
@@ -511,6 +626,226 @@ void ExternalCuts::get_col(const int end0, const int end1,
     } CMR_CATCH_PRINT_THROW("Couldn't push back column coeffs/inds", err);
 }
 
+/**
+ * The clique edge index stores, for each Clique of a non-domino cut, the
+ * indices of edges in \p core_graph having exactly one end in the Clique.
+ * Once this is called the index is kept current as cuts are added or deleted,
+ * and by core_edges_added and core_edges_removed as the core changes.
+ * @param core_graph the graph whose edges are indexed. It must outlive this
+ * object, and its edges should only be modified in tandem with calls to the
+ * update methods above.
+ */
+void ExternalCuts::index_core_edges(const Graph::CoreGraph &core_graph)
+{
+    runtime_error err("Problem in ExternalCuts::index_core_edges");
+
+    index_graph = &core_graph;
+    indexed_ecount = core_graph.edge_count();
+    clique_edge_index.clear();
+
+    try {
+        for (const HyperGraph &H : cuts)
+            index_cut(H);
+    } CMR_CATCH_PRINT_THROW("indexing cut cliques", err);
+}
+
+/**
+ * @param old_ecount the number of core edges before the new ones were
+ * appended. Edges with index at least \p old_ecount are tested against every
+ * Clique in the index.
+ */
+void ExternalCuts::core_edges_added(int old_ecount)
+{
+    if (index_graph == nullptr)
+        return;
+
+    const vector<Graph::Edge> &edges = index_graph->get_edges();
+    const vector<int> &perm = clique_bank.ref_perm();
+    int ecount = edges.size();
+
+    for (std::pair<const CliqueId, vector<int>> &kv : clique_edge_index) {
+        CliqueId id = kv.first;
+        vector<int> &cut_edges = kv.second;
+
+        for (int i = old_ecount; i < ecount; ++i) {
+            const Graph::Edge &e = edges[i];
+            if (clique_bank.contains(id, perm[e.end[0]]) !=
+                clique_bank.contains(id, perm[e.end[1]]))
+                cut_edges.push_back(i);
+        }
+    }
+
+    indexed_ecount = ecount;
+}
+
+/**
+ * @param edge_delstat a vector of length equal to the edge count prior to
+ * removal, with `edge_delstat[i] == 1` if edge `i` was removed. Surviving
+ * edges are renumbered to match the order kept by Graph::CoreGraph.
+ */
+void ExternalCuts::core_edges_removed(const vector<int> &edge_delstat)
+{
+    if (index_graph == nullptr)
+        return;
+
+    if (edge_delstat.size() != indexed_ecount)
+        throw runtime_error("Size mismatch in ExternalCuts::core_edges_removed");
+
+    vector<int> new_index(edge_delstat.size());
+    int ecount = 0;
+
+    for (int i = 0; i < edge_delstat.size(); ++i)
+        new_index[i] = (edge_delstat[i] == 1) ? -1 : ecount++;
+
+    for (std::pair<const CliqueId, vector<int>> &kv : clique_edge_index) {
+        vector<int> &cut_edges = kv.second;
+
+        for (int &ind : cut_edges)
+            ind = new_index[ind];
+
+        cut_edges.erase(std::remove(cut_edges.begin(), cut_edges.end(), -1),
+                        cut_edges.end());
+    }
+
+    indexed_ecount = ecount;
+}
+
+/**
+ * @returns a pointer to the list of indices of core edges with exactly one
+ * end in the Clique \p id, or nullptr if \p id is not in the index.
+ */
+const vector<int> *ExternalCuts::clique_edges(CliqueId id) const
+{
+    auto it = clique_edge_index.find(id);
+    if (it == clique_edge_index.end())
+        return nullptr;
+
+    return &it->second;
+}
+
+void ExternalCuts::index_cut(const HyperGraph &H)
+{
+    if (index_graph == nullptr)
+        return;
+
+    HyperGraph::Type t = H.cut_type();
+    if (t == HyperGraph::Type::Domino || t == HyperGraph::Type::Non)
+        return;
+
+    for (CliqueId id : H.cliques)
+        if (clique_edge_index.count(id) == 0)
+            index_clique(id);
+}
+
+/**
+ * The edges are found by marking the nodes of the Clique \p id and scanning
+ * the core adjacency lists of those nodes for neighbors which are unmarked.
+ */
+void ExternalCuts::index_clique(CliqueId id)
+{
+    const vector<int> &def_tour = clique_bank.ref_tour();
+    const vector<Graph::Node> &nodelist = index_graph->get_adj().nodelist;
+
+    ++index_marker;
+
+    for (const Segment &seg : clique_bank.seg_list(id))
+        for (int k = seg.start; k <= seg.end; ++k)
+            index_marks[def_tour[k]] = index_marker;
+
+    vector<int> &cut_edges = clique_edge_index[id];
+
+    for (const Segment &seg : clique_bank.seg_list(id))
+        for (int k = seg.start; k <= seg.end; ++k)
+            for (const Graph::AdjObj &a : nodelist[def_tour[k]].neighbors)
+                if (index_marks[a.other_end] != index_marker)
+                    cut_edges.push_back(a.edge_index);
+
+    std::sort(cut_edges.begin(), cut_edges.end());
+}
+
+/**
+ * Computes the same columns as calling get_col on each edge of \p batch, but
+ * the edge ends are mapped to tour positions once, and the coefficients of
+ * each cut on the whole batch are found in one pass by HyperGraph::pos_coeffs.
+ * The rows are then transposed into columns.
+ * @param[in] batch the edges to be added.
+ * @param[out] cmatbeg `cmatbeg[j]` is the start of the column for
+ * `batch[j]` in \p cmatind and \p cmatval.
+ * @param[out] cmatind the row indices of nonzero coefficients, with the
+ * degree equations of each column first, followed by cuts in increasing
+ * order.
+ * @param[out] cmatval the coefficients corresponding to \p cmatind.
+ */
+void ExternalCuts::get_cols(const vector<Graph::Edge> &batch,
+                            vector<int> &cmatbeg, vector<int> &cmatind,
+                            vector<double> &cmatval) const
+{
+    runtime_error err("Problem in ExternalCuts::get_cols");
+
+    int bcount = batch.size();
+    int cutcount = cuts.size();
+
+    cmatbeg.clear();
+    cmatind.clear();
+    cmatval.clear();
+
+    vector<int> end_pos;
+    vector<vector<int>> row_inds(cutcount);
+    vector<vector<double>> row_vals(cutcount);
+    vector<int> col_sizes(bcount, 2);
+
+    try {
+        for (const Graph::Edge &e : batch)
+            if (e.end[0] == e.end[1]) {
+                cerr << "Edge has same endpoints.\n";
+                throw err;
+            }
+
+        HyperGraph::tour_positions(batch, clique_bank.ref_perm(), end_pos);
+
+        for (int i = 0; i < cutcount; ++i) {
+            cuts[i].pos_coeffs(end_pos, row_inds[i], row_vals[i]);
+            for (int j : row_inds[i])
+                ++col_sizes[j];
+        }
+    } CMR_CATCH_PRINT_THROW("computing cut rows on batch", err);
+
+    try {
+        cmatbeg.resize(bcount);
+        int nzcount = 0;
+
+        for (int j = 0; j < bcount; ++j) {
+            cmatbeg[j] = nzcount;
+            nzcount += col_sizes[j];
+        }
+
+        cmatind.resize(nzcount);
+        cmatval.resize(nzcount);
+
+        vector<int> &fill = col_sizes;
+
+        for (int j = 0; j < bcount; ++j) {
+            int beg = cmatbeg[j];
+            cmatind[beg] = batch[j].end[0];
+            cmatind[beg + 1] = batch[j].end[1];
+            cmatval[beg] = 1.0;
+            cmatval[beg + 1] = 1.0;
+            fill[j] = beg + 2;
+        }
+
+        for (int i = 0; i < cutcount; ++i) {
+            int index = i + node_count;
+
+            for (int k = 0; k < row_inds[i].size(); ++k) {
+                int j = row_inds[i][k];
+                cmatind[fill[j]] = index;
+                cmatval[fill[j]] = row_vals[i][k];
+                ++fill[j];
+            }
+        }
+    } CMR_CATCH_PRINT_THROW("transposing rows to columns", err);
+}
+
 void ExternalCuts::pool_add(const HyperGraph &H)
 {
     runtime_error err("Problem in ExternalCuts::pool_add");
@@ -531,6 +866,602 @@ void ExternalCuts::pool_add(const HyperGraph &H)
         throw runtime_error("CCtsp_add_to_cutpool_lpcut_in failed");
 }
 
+/// Leading bytes of a binary cut pool file.
+static const char PoolMagic[8] = {'C', 'M', 'R', 'P', 'O', 'O', 'L', '\0'};
+
+constexpr std::int32_t PoolVersion = 1; //!< Current pool file version.
+
+/// The fixed size header of a binary cut pool file.
+struct PoolHeader {
+    char magic[8];
+    std::int32_t version;
+    std::int32_t ncount; //!< Number of nodes in the saved tour.
+    std::int32_t cutcount; //!< Number of cuts.
+    std::int32_t cliquecount; //!< Number of distinct cliques.
+    std::int32_t segcount; //!< Total segments over all cliques.
+    std::int32_t refcount; //!< Total clique references over all cuts.
+};
+
+/// The size in bytes of a pool file with header \p h.
+static std::size_t pool_file_size(const PoolHeader &h)
+{
+    using std::size_t;
+    size_t ints = size_t(h.ncount) + size_t(h.cliquecount) + 1 +
+                  2 * size_t(h.segcount) + size_t(h.cutcount) + 1 +
+                  size_t(h.refcount) + 2 * size_t(h.cutcount);
+
+    return sizeof(PoolHeader) + ints * sizeof(std::int32_t);
+}
+
+/// Write the \p count ints starting at \p vals to \p out.
+static void write_ints(std::ofstream &out, const std::int32_t *vals,
+                       std::size_t count)
+{
+    out.write(reinterpret_cast<const char *>(vals),
+              count * sizeof(std::int32_t));
+}
+
+/**
+ * @param pool the Concorde cut pool to add to.
+ * @param ncount the number of nodes, for the skeleton of the cut.
+ * @param rhs the righthand side of the cut.
+ * @param sense the sense of the cut.
+ * @param cliques for each clique, its positions in the pool's reference
+ * tour, sorted.
+ */
+static void add_pool_cut(CCtsp_lpcuts *pool, int ncount, int rhs, char sense,
+                         const vector<vector<int> *> &cliques)
+{
+    runtime_error err("Problem in add_pool_cut");
+
+    lpcut_in c;
+    CCtsp_init_lpcut_in(&c);
+    auto c_guard = util::make_guard([&c] { CCtsp_free_lpcut_in(&c); });
+
+    c.rhs = rhs;
+    c.sense = sense;
+
+    int cliquecount = cliques.size();
+    if (CCtsp_create_lpcliques(&c, cliquecount))
+        throw err;
+
+    for (int k = 0; k < cliquecount; ++k) {
+        vector<int> &nodes = *cliques[k];
+        if (CCtsp_array_to_lpclique(&nodes[0], nodes.size(), c.cliques + k))
+            throw err;
+    }
+
+    if (CCtsp_construct_skeleton(&c, ncount))
+        throw err;
+
+    if (CCtsp_add_to_cutpool_lpcut_in(pool, &c))
+        throw runtime_error("CCtsp_add_to_cutpool_lpcut_in failed");
+}
+
+/**
+ * A pool file stores cliques as segments of positions in the reference tour
+ * of #clique_bank, which is written to the file as well. After a PoolHeader,
+ * the file is a sequence of native-endian 32-bit integer arrays:
+ *  - the saved tour, `ncount` nodes;
+ *  - clique offsets into the segments, `cliquecount + 1` entries;
+ *  - segments as start/end position pairs, `2 * segcount` entries;
+ *  - cut offsets into the clique references, `cutcount + 1` entries;
+ *  - clique references, `refcount` indices of cliques;
+ *  - cut righthand sides, `cutcount` entries;
+ *  - cut senses as characters, `cutcount` entries.
+ *
+ * Cliques shared by several cuts are written once. The cuts written are
+ * those in #cc_pool followed by the Subtour and Comb cuts in the LP; domino
+ * and non-HyperGraph cuts are skipped. The file is written to a temporary
+ * name and then renamed over \p fname, so an interrupted save leaves any
+ * previous pool intact.
+ */
+void ExternalCuts::save_pool(const string &fname) const
+{
+    runtime_error err("Problem in ExternalCuts::save_pool");
+
+    vector<std::int32_t> clique_beg{0};
+    vector<std::int32_t> segs;
+    vector<std::int32_t> cut_beg{0};
+    vector<std::int32_t> cut_refs;
+    vector<std::int32_t> cut_rhs;
+    vector<std::int32_t> cut_sense;
+
+    try {
+        if (cc_pool) {
+            vector<int> pool_index(cc_pool->cliqueend, -1);
+
+            for (int i = 0; i < cc_pool->cutcount; ++i) {
+                const CCtsp_lpcut &c = cc_pool->cuts[i];
+                if (c.dominocount > 0)
+                    continue;
+
+                for (int k = 0; k < c.cliquecount; ++k) {
+                    int &ind = pool_index[c.cliques[k]];
+                    if (ind == -1) {
+                        const lpclique &clq = cc_pool->cliques[c.cliques[k]];
+                        for (int j = 0; j < clq.segcount; ++j) {
+                            segs.push_back(clq.nodes[j].lo);
+                            segs.push_back(clq.nodes[j].hi);
+                        }
+                        ind = clique_beg.size() - 1;
+                        clique_beg.push_back(segs.size() / 2);
+                    }
+                    cut_refs.push_back(ind);
+                }
+
+                cut_beg.push_back(cut_refs.size());
+                cut_rhs.push_back(c.rhs);
+                cut_sense.push_back(c.sense);
+            }
+        }
+
+        unordered_map<CliqueId, int> bank_index;
+
+        for (const HyperGraph &H : cuts) {
+            HyperGraph::Type t = H.cut_type();
+            if ((t != HyperGraph::Type::Subtour &&
+                 t != HyperGraph::Type::Comb) || H.source_bank != &clique_bank)
+                continue;
+
+            for (CliqueId id : H.cliques) {
+                auto it = bank_index.find(id);
+                if (it == bank_index.end()) {
+                    for (const Segment &seg : clique_bank.seg_list(id)) {
+                        segs.push_back(seg.start);
+                        segs.push_back(seg.end);
+                    }
+                    it = bank_index.emplace(id, clique_beg.size() - 1).first;
+                    clique_beg.push_back(segs.size() / 2);
+                }
+                cut_refs.push_back(it->second);
+            }
+
+            cut_beg.push_back(cut_refs.size());
+            cut_rhs.push_back(static_cast<std::int32_t>(H.rhs));
+            cut_sense.push_back(H.sense);
+        }
+    } CMR_CATCH_PRINT_THROW("collecting pool cuts", err);
+
+    const vector<int> &tour = clique_bank.ref_tour();
+    vector<std::int32_t> saved_tour(tour.begin(), tour.end());
+
+    PoolHeader h;
+    std::memcpy(h.magic, PoolMagic, sizeof(PoolMagic));
+    h.version = PoolVersion;
+    h.ncount = node_count;
+    h.cutcount = cut_rhs.size();
+    h.cliquecount = clique_beg.size() - 1;
+    h.segcount = segs.size() / 2;
+    h.refcount = cut_refs.size();
+
+    string tmp_fname = fname + ".tmp";
+
+    {
+        std::ofstream out(tmp_fname, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            cerr << "Couldn't open " << tmp_fname << " for writing" << endl;
+            throw err;
+        }
+
+        out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+        write_ints(out, saved_tour.data(), saved_tour.size());
+        write_ints(out, clique_beg.data(), clique_beg.size());
+        write_ints(out, segs.data(), segs.size());
+        write_ints(out, cut_beg.data(), cut_beg.size());
+        write_ints(out, cut_refs.data(), cut_refs.size());
+        write_ints(out, cut_rhs.data(), cut_rhs.size());
+        write_ints(out, cut_sense.data(), cut_sense.size());
+
+        out.close();
+        if (!out) {
+            cerr << "Failed writing " << tmp_fname << endl;
+            std::remove(tmp_fname.c_str());
+            throw err;
+        }
+    }
+
+    if (std::rename(tmp_fname.c_str(), fname.c_str()) != 0) {
+        cerr << "Couldn't rename " << tmp_fname << " to " << fname << endl;
+        std::remove(tmp_fname.c_str());
+        throw err;
+    }
+}
+
+/**
+ * The file is memory-mapped and validated against its header before any
+ * cut is added. Clique segments are mapped from positions in the saved tour
+ * to positions in the reference tour of #clique_bank, so the file may have
+ * been written with a different starting tour. Every cut is added to
+ * #cc_pool, where Separator::pool_sep will find it from the first round.
+ * @param fname the pool file, as written by save_pool.
+ * @returns the number of cuts read, or zero if \p fname does not exist.
+ * @throws std::runtime_error if \p fname is malformed or written for an
+ * instance with a different number of nodes.
+ */
+int ExternalCuts::load_pool(const string &fname)
+{
+    using std::int32_t;
+    runtime_error err("Problem in ExternalCuts::load_pool");
+
+    int fd = ::open(fname.c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (errno == ENOENT)
+            return 0;
+        cerr << "Couldn't open pool file " << fname << endl;
+        throw err;
+    }
+    auto fd_guard = util::make_guard([fd] { ::close(fd); });
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 ||
+        static_cast<std::size_t>(st.st_size) < sizeof(PoolHeader)) {
+        cerr << "Pool file " << fname << " is truncated" << endl;
+        throw err;
+    }
+
+    std::size_t fsize = st.st_size;
+    void *map = ::mmap(nullptr, fsize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        cerr << "Couldn't map pool file " << fname << endl;
+        throw err;
+    }
+    auto map_guard = util::make_guard([map, fsize] { ::munmap(map, fsize); });
+
+    PoolHeader h;
+    std::memcpy(&h, map, sizeof(h));
+
+    if (std::memcmp(h.magic, PoolMagic, sizeof(PoolMagic)) != 0 ||
+        h.version != PoolVersion) {
+        cerr << fname << " is not a version " << PoolVersion
+             << " pool file" << endl;
+        throw err;
+    }
+
+    if (h.ncount != node_count) {
+        cerr << "Pool file " << fname << " has " << h.ncount
+             << " nodes, instance has " << node_count << endl;
+        throw err;
+    }
+
+    if (h.cutcount < 0 || h.cliquecount < 0 || h.segcount < 0 ||
+        h.refcount < 0 || pool_file_size(h) != fsize) {
+        cerr << "Pool file " << fname << " has inconsistent size" << endl;
+        throw err;
+    }
+
+    const int32_t *saved_tour = reinterpret_cast<const int32_t *>(
+        static_cast<const char *>(map) + sizeof(PoolHeader));
+    const int32_t *clique_beg = saved_tour + h.ncount;
+    const int32_t *segs = clique_beg + h.cliquecount + 1;
+    const int32_t *cut_beg = segs + 2 * h.segcount;
+    const int32_t *cut_refs = cut_beg + h.cutcount + 1;
+    const int32_t *cut_rhs = cut_refs + h.refcount;
+    const int32_t *cut_sense = cut_rhs + h.cutcount;
+
+    const vector<int> &perm = clique_bank.ref_perm();
+    vector<int> new_pos;
+
+    try {
+        new_pos.resize(h.ncount, -1);
+        for (int p = 0; p < h.ncount; ++p) {
+            int node = saved_tour[p];
+            if (node < 0 || node >= h.ncount)
+                throw runtime_error("Saved tour is not a permutation");
+            new_pos[p] = perm[node];
+        }
+
+        vector<int> seen(h.ncount, 0);
+        for (int p = 0; p < h.ncount; ++p)
+            if (seen[new_pos[p]]++)
+                throw runtime_error("Saved tour is not a permutation");
+
+        for (int i = 0; i < h.cliquecount; ++i)
+            if (clique_beg[i] >= clique_beg[i + 1])
+                throw runtime_error("Bad clique offsets");
+        if (clique_beg[0] != 0 || clique_beg[h.cliquecount] != h.segcount)
+            throw runtime_error("Bad clique offsets");
+
+        for (int i = 0; i < h.segcount; ++i)
+            if (segs[2 * i] < 0 || segs[2 * i] > segs[2 * i + 1] ||
+                segs[2 * i + 1] >= h.ncount)
+                throw runtime_error("Bad segment");
+
+        for (int i = 0; i < h.cutcount; ++i)
+            if (cut_beg[i] >= cut_beg[i + 1])
+                throw runtime_error("Bad cut offsets");
+        if (cut_beg[0] != 0 || cut_beg[h.cutcount] != h.refcount)
+            throw runtime_error("Bad cut offsets");
+
+        for (int i = 0; i < h.refcount; ++i)
+            if (cut_refs[i] < 0 || cut_refs[i] >= h.cliquecount)
+                throw runtime_error("Bad clique reference");
+
+        for (int i = 0; i < h.cutcount; ++i)
+            if (cut_sense[i] != 'G' && cut_sense[i] != 'L' &&
+                cut_sense[i] != 'E')
+                throw runtime_error("Bad cut sense");
+    } catch (const exception &e) {
+        cerr << e.what() << " in pool file " << fname << endl;
+        throw err;
+    }
+
+    vector<vector<int>> clique_nodes;
+
+    try {
+        clique_nodes.resize(h.cliquecount);
+        for (int i = 0; i < h.cliquecount; ++i) {
+            vector<int> &nodes = clique_nodes[i];
+            for (int k = clique_beg[i]; k < clique_beg[i + 1]; ++k)
+                for (int p = segs[2 * k]; p <= segs[2 * k + 1]; ++p)
+                    nodes.push_back(new_pos[p]);
+            std::sort(nodes.begin(), nodes.end());
+        }
+    } CMR_CATCH_PRINT_THROW("mapping pool cliques", err);
+
+    vector<vector<int> *> cut_cliques;
+
+    for (int i = 0; i < h.cutcount; ++i) {
+        cut_cliques.clear();
+        for (int k = cut_beg[i]; k < cut_beg[i + 1]; ++k)
+            cut_cliques.push_back(&clique_nodes[cut_refs[k]]);
+
+        try {
+            add_pool_cut(cc_pool, node_count, cut_rhs[i], cut_sense[i],
+                         cut_cliques);
+        } CMR_CATCH_PRINT_THROW("adding cut to pool", err);
+    }
+
+    return h.cutcount;
+}
+
+/// Append the segments from \p first to \p last to \p img as a new clique.
+/// @returns the index of the clique in \p img.
+static int image_clique(CutImage &img, const Segment *first,
+                        const Segment *last)
+{
+    bool sorted = true;
+
+    for (const Segment *seg = first; seg != last; ++seg) {
+        if (seg != first && (seg - 1)->end >= seg->start)
+            sorted = false;
+        img.segs.push_back(seg->start);
+        img.segs.push_back(seg->end);
+    }
+
+    img.clique_sorted.push_back(sorted);
+    img.clique_beg.push_back(img.segs.size() / 2);
+
+    return img.clique_beg.size() - 2;
+}
+
+/**
+ * Every cut in the LP is copied with its ages, along with the cuts in
+ * #cc_pool other than dominoes, which are skipped as in save_pool. Cliques
+ * of #clique_bank shared by several LP cuts are copied once.
+ * @throws std::runtime_error if the LP has a Non HyperGraph cut, since its
+ * row cannot be recovered from the cut alone.
+ */
+CutImage ExternalCuts::get_image() const
+{
+    runtime_error err("Problem in ExternalCuts::get_image");
+    CutImage img;
+
+    try {
+        img.ref_tour = clique_bank.ref_tour();
+        img.clique_beg.push_back(0);
+        img.cut_beg.push_back(0);
+        img.tooth_beg.push_back(0);
+
+        unordered_map<CliqueId, int> bank_index;
+
+        for (const HyperGraph &H : cuts) {
+            if (H.cut_type() == HyperGraph::Type::Non)
+                throw runtime_error("Non HyperGraph cut in LP");
+
+            for (CliqueId id : H.cliques) {
+                auto it = bank_index.find(id);
+                if (it == bank_index.end()) {
+                    SegRange segs = clique_bank.seg_list(id);
+                    int ind = image_clique(img, segs.begin(), segs.end());
+                    it = bank_index.emplace(id, ind).first;
+                }
+                img.clique_refs.push_back(it->second);
+            }
+
+            for (const Tooth::Ptr &T : H.teeth)
+                for (const Clique &clq : T->set_pair()) {
+                    const vector<Segment> &segs = clq.seg_list();
+                    img.tooth_refs.push_back(image_clique(img, segs.data(),
+                                                          segs.data() +
+                                                          segs.size()));
+                }
+
+            img.cut_beg.push_back(img.clique_refs.size());
+            img.tooth_beg.push_back(img.tooth_refs.size() / 2);
+            img.sense.push_back(H.sense);
+            img.rhs.push_back(H.rhs);
+            img.ages.push_back(H.t_age);
+            img.ages.push_back(H.p_age);
+        }
+
+        img.lp_count = cuts.size();
+
+        if (cc_pool) {
+            vector<int> pool_index(cc_pool->cliqueend, -1);
+            vector<Segment> segs;
+
+            for (int i = 0; i < cc_pool->cutcount; ++i) {
+                const CCtsp_lpcut &c = cc_pool->cuts[i];
+                if (c.dominocount > 0)
+                    continue;
+
+                for (int k = 0; k < c.cliquecount; ++k) {
+                    int &ind = pool_index[c.cliques[k]];
+                    if (ind == -1) {
+                        const lpclique &clq = cc_pool->cliques[c.cliques[k]];
+                        segs.clear();
+                        for (int j = 0; j < clq.segcount; ++j)
+                            segs.emplace_back(clq.nodes[j].lo,
+                                              clq.nodes[j].hi);
+                        ind = image_clique(img, segs.data(),
+                                           segs.data() + segs.size());
+                    }
+                    img.clique_refs.push_back(ind);
+                }
+
+                img.cut_beg.push_back(img.clique_refs.size());
+                img.tooth_beg.push_back(img.tooth_refs.size() / 2);
+                img.sense.push_back(c.sense);
+                img.rhs.push_back(c.rhs);
+            }
+        }
+    } CMR_CATCH_PRINT_THROW("copying cuts", err);
+
+    return img;
+}
+
+/**
+ * The cliques of \p img are mapped from positions in CutImage::ref_tour to
+ * positions in the reference tour of #clique_bank, so the two tours may
+ * differ. The LP cuts are built in #clique_bank and #tooth_bank and queued
+ * in \p lp_q, in order, to be added to the LP by CoreLP::add_cuts. The pool
+ * cuts are added to #cc_pool directly.
+ * @throws std::runtime_error if \p img is inconsistent or was made for an
+ * instance with a different number of nodes.
+ */
+void ExternalCuts::load_image(const CutImage &img,
+                              CutQueue<HyperGraph> &lp_q)
+{
+    runtime_error err("Problem in ExternalCuts::load_image");
+
+    int cliquecount = img.clique_sorted.size();
+    int segcount = img.segs.size() / 2;
+    int cutcount = img.sense.size();
+    const vector<int> &perm = clique_bank.ref_perm();
+
+    try {
+        if (img.ref_tour.size() != node_count)
+            throw runtime_error("Reference tour has wrong node count");
+
+        vector<int> seen(node_count, 0);
+        for (int n : img.ref_tour)
+            if (n < 0 || n >= node_count || seen[n]++)
+                throw runtime_error("Reference tour is not a permutation");
+
+        if (img.clique_beg.size() != cliquecount + 1 ||
+            img.clique_beg.front() != 0 ||
+            img.clique_beg.back() != segcount || img.segs.size() % 2 != 0)
+            throw runtime_error("Bad clique offsets");
+        for (int i = 0; i < cliquecount; ++i)
+            if (img.clique_beg[i] >= img.clique_beg[i + 1])
+                throw runtime_error("Bad clique offsets");
+
+        for (int i = 0; i < segcount; ++i)
+            if (img.segs[2 * i] < 0 || img.segs[2 * i] > img.segs[2 * i + 1]
+                || img.segs[2 * i + 1] >= node_count)
+                throw runtime_error("Bad segment");
+
+        if (img.rhs.size() != cutcount || img.cut_beg.size() != cutcount + 1 ||
+            img.tooth_beg.size() != cutcount + 1 || img.lp_count < 0 ||
+            img.lp_count > cutcount || img.ages.size() != 2 * img.lp_count)
+            throw runtime_error("Bad cut counts");
+
+        if (img.cut_beg.front() != 0 ||
+            img.cut_beg.back() != img.clique_refs.size() ||
+            img.tooth_beg.front() != 0 ||
+            2 * img.tooth_beg.back() != img.tooth_refs.size())
+            throw runtime_error("Bad cut offsets");
+        for (int i = 0; i < cutcount; ++i)
+            if (img.cut_beg[i] >= img.cut_beg[i + 1] ||
+                img.tooth_beg[i] > img.tooth_beg[i + 1] ||
+                (i >= img.lp_count && img.tooth_beg[i] < img.tooth_beg[i + 1]))
+                throw runtime_error("Bad cut offsets");
+
+        for (int ind : img.clique_refs)
+            if (ind < 0 || ind >= cliquecount)
+                throw runtime_error("Bad clique reference");
+        for (int ind : img.tooth_refs)
+            if (ind < 0 || ind >= cliquecount)
+                throw runtime_error("Bad tooth reference");
+
+        for (char sense : img.sense)
+            if (sense != 'G' && sense != 'L' && sense != 'E')
+                throw runtime_error("Bad cut sense");
+    } catch (const exception &e) {
+        cerr << e.what() << " in CutImage" << endl;
+        throw err;
+    }
+
+    vector<Clique> cliques;
+    vector<vector<int>> pool_cliques(cliquecount);
+
+    try {
+        cliques.reserve(cliquecount);
+        vector<int> nodes;
+
+        for (int i = 0; i < cliquecount; ++i) {
+            nodes.clear();
+            for (int k = img.clique_beg[i]; k < img.clique_beg[i + 1]; ++k)
+                for (int p = img.segs[2 * k]; p <= img.segs[2 * k + 1]; ++p)
+                    nodes.push_back(img.ref_tour[p]);
+            cliques.emplace_back(nodes, perm, !img.clique_sorted[i]);
+        }
+    } CMR_CATCH_PRINT_THROW("mapping image cliques", err);
+
+    for (int i = 0; i < img.lp_count; ++i) {
+        HyperGraph H;
+
+        try {
+            H.sense = img.sense[i];
+            H.rhs = img.rhs[i];
+            H.t_age = img.ages[2 * i];
+            H.p_age = img.ages[2 * i + 1];
+            H.source_bank = &clique_bank;
+
+            for (int k = img.cut_beg[i]; k < img.cut_beg[i + 1]; ++k)
+                H.cliques.push_back(clique_bank.add_clique(
+                                        cliques[img.clique_refs[k]]));
+
+            if (img.tooth_beg[i] < img.tooth_beg[i + 1])
+                H.source_toothbank = &tooth_bank;
+
+            for (int t = img.tooth_beg[i]; t < img.tooth_beg[i + 1]; ++t)
+                H.teeth.push_back(tooth_bank.add_tooth(
+                                      cliques[img.tooth_refs[2 * t]],
+                                      cliques[img.tooth_refs[2 * t + 1]]));
+
+            lp_q.emplace_back(std::move(H));
+        } CMR_CATCH_PRINT_THROW("building LP cut", err);
+    }
+
+    vector<vector<int> *> cut_cliques;
+
+    for (int i = img.lp_count; i < cutcount; ++i) {
+        cut_cliques.clear();
+
+        try {
+            for (int k = img.cut_beg[i]; k < img.cut_beg[i + 1]; ++k) {
+                int ind = img.clique_refs[k];
+                vector<int> &pos = pool_cliques[ind];
+                if (pos.empty()) {
+                    for (int j = img.clique_beg[ind];
+                         j < img.clique_beg[ind + 1]; ++j)
+                        for (int p = img.segs[2 * j];
+                             p <= img.segs[2 * j + 1]; ++p)
+                            pos.push_back(perm[img.ref_tour[p]]);
+                    std::sort(pos.begin(), pos.end());
+                }
+                cut_cliques.push_back(&pos);
+            }
+
+            add_pool_cut(cc_pool, node_count, img.rhs[i], img.sense[i],
+                         cut_cliques);
+        } CMR_CATCH_PRINT_THROW("adding cut to pool", err);
+    }
+}
+
+
 
 }
 }
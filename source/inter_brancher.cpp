@@ -55,13 +55,32 @@ void InterBrancher::enqueue_split(BranchNode::Split prob_array) try
 {
     for (BranchNode &B : prob_array) {
         branch_history.emplace_front(std::move(B));
-        heap_push(prob_q, branch_history.begin());
+        if (!branch_history.front().visited())
+            heap_push(prob_q, branch_history.begin());
     }
 } catch (const exception &e) {
     cerr << e.what() << " putting nodes in history" << endl;
     throw runtime_error("InterBrancher::enqueue_split failed.");
 }
 
+/**
+ * The interleaving counter is restored as well: one node is fetched for each
+ * node visited, plus one for \p cur.
+ */
+void InterBrancher::rebuild_queue(BranchHistory::iterator cur)
+{
+    prob_q.clear();
+    node_num = 2;
+
+    for (auto it = branch_history.begin(); it != branch_history.end(); ++it)
+        if (it->visited())
+            ++node_num;
+        else if (it != cur)
+            prob_q.push_back(it);
+
+    heap_make(prob_q);
+}
+
 BranchHistory::iterator InterBrancher::next_prob()
 {
     if (verbose)
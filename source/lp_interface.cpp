@@ -4,6 +4,8 @@
 #include "config.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <stdexcept>
 #include <iostream>
 #include <limits>
@@ -12,9 +14,14 @@
 #include <utility>
 
 #include <cfenv>
+#include <cstddef>
 
 #include <cplex.h>
 
+#if CMR_USE_OMP
+#include <omp.h>
+#endif
+
 #if CMR_HAVE_SAFEGMI
 
 #include "mirgroup.hpp"
@@ -59,6 +66,31 @@ struct Relaxation::solver_impl {
 
     CPXENVptr env; //!< The CPLEX environment.
     CPXLPptr lp; //!< The LP problem object.
+
+    ThreadPolicy policy; //!< The policy for full_opt.
+
+    /// Clones used to evaluate strong branch candidates in parallel.
+    /// They are kept between calls to primal_strong_branch, and brought up
+    /// to date by replaying the changes in journal.
+    vector<Relaxation> sb_workers;
+
+    /// Changes to the problem since sb_workers were last synced.
+    vector<std::function<void(Relaxation &)>> journal;
+
+    std::size_t journal_size = 0; //!< Number of entries copied into journal.
+
+    /// Record \p change of \p size entries, if there are workers to sync.
+    template <typename Change>
+    void log_change(Change change, std::size_t size)
+        {
+            if (sb_workers.empty())
+                return;
+            journal.emplace_back(std::move(change));
+            journal_size += size + 1;
+        }
+
+    /// Make \p count workers matching \p master available in sb_workers.
+    void sync_workers(const Relaxation &master, int count);
 };
 
 /// Construct a solver_impl with empty data, initializing parameters.
@@ -307,6 +339,99 @@ Relaxation& Relaxation::operator=(Relaxation &&lp) noexcept
 
 Relaxation::~Relaxation() {}
 
+/**
+ * The returned Relaxation has the same rows, columns, bounds, and objective
+ * as this one, but lives in a new CPLEX environment with the default
+ * parameters of the solver_impl constructor. Thus it may be optimized in a
+ * separate thread from this one. No basis or solution is copied.
+ */
+Relaxation Relaxation::clone() const
+{
+    runtime_error err("Problem in Relaxation::clone.");
+
+    CPXENVptr env = simpl_p->env;
+    CPXLPptr lp = simpl_p->lp;
+
+    int ncols = num_cols();
+    int nrows = num_rows();
+    int objsen = CPXgetobjsen(env, lp);
+
+    vector<double> obj;
+    vector<double> lb;
+    vector<double> ub;
+    vector<double> rhs;
+    vector<char> sense;
+    vector<int> matbeg;
+    vector<int> matcnt;
+    vector<int> matind;
+    vector<double> matval;
+
+    try {
+        obj.resize(ncols);
+        lb.resize(ncols);
+        ub.resize(ncols);
+        rhs.resize(nrows);
+        sense.resize(nrows);
+        matbeg.resize(ncols);
+        matcnt.resize(ncols);
+    } CMR_CATCH_PRINT_THROW("allocating problem data", err);
+
+    int rval = 0;
+
+    if (ncols > 0) {
+        if ((rval = CPXgetobj(env, lp, &obj[0], 0, ncols - 1)))
+            throw cpx_err(rval, "CPXgetobj");
+        if ((rval = CPXgetlb(env, lp, &lb[0], 0, ncols - 1)))
+            throw cpx_err(rval, "CPXgetlb");
+        if ((rval = CPXgetub(env, lp, &ub[0], 0, ncols - 1)))
+            throw cpx_err(rval, "CPXgetub");
+    }
+
+    if (nrows > 0) {
+        if ((rval = CPXgetrhs(env, lp, &rhs[0], 0, nrows - 1)))
+            throw cpx_err(rval, "CPXgetrhs");
+        if ((rval = CPXgetsense(env, lp, &sense[0], 0, nrows - 1)))
+            throw cpx_err(rval, "CPXgetsense");
+    }
+
+    if (ncols > 0 && nrows > 0) {
+        int nzcnt = 0;
+        int surplus = 0;
+
+        rval = CPXgetcols(env, lp, &nzcnt, &matbeg[0], NULL, NULL, 0,
+                          &surplus, 0, ncols - 1);
+        if (rval != CPXERR_NEGATIVE_SURPLUS && rval != 0)
+            throw cpx_err(rval, "CPXgetcols initial");
+
+        try {
+            matind.resize(-surplus);
+            matval.resize(-surplus);
+        } CMR_CATCH_PRINT_THROW("allocating matrix", err);
+
+        if (!matind.empty()) {
+            rval = CPXgetcols(env, lp, &nzcnt, &matbeg[0], &matind[0],
+                              &matval[0], matind.size(), &surplus, 0,
+                              ncols - 1);
+            if (rval)
+                throw cpx_err(rval, "CPXgetcols actual");
+        }
+
+        for (int j = 0; j < ncols; ++j)
+            matcnt[j] = ((j + 1 < ncols) ? matbeg[j + 1] : nzcnt) - matbeg[j];
+    }
+
+    Relaxation result;
+
+    rval = CPXcopylp(result.simpl_p->env, result.simpl_p->lp, ncols, nrows,
+                     objsen, obj.data(), rhs.data(), sense.data(),
+                     matbeg.data(), matcnt.data(), matind.data(),
+                     matval.data(), lb.data(), ub.data(), NULL);
+    if (rval)
+        throw cpx_err(rval, "CPXcopylp");
+
+    return result;
+}
+
 int Relaxation::num_rows() const
 {
     return CPXgetnumrows(simpl_p->env, simpl_p->lp);
@@ -443,6 +568,9 @@ void Relaxation::new_row(const char sense, const double rhs)
 
     if (rval)
         throw cpx_err(rval, "CPXnewrows");
+
+    simpl_p->log_change([sense, rhs](Relaxation &w)
+                        { w.new_row(sense, rhs); }, 2);
 }
 
 void Relaxation::new_rows(const vector<char> &sense,
@@ -452,6 +580,9 @@ void Relaxation::new_rows(const vector<char> &sense,
                           sense.data(), NULL, NULL);
     if (rval)
         throw cpx_err(rval, "CPXnewrows");
+
+    simpl_p->log_change([sense, rhs](Relaxation &w)
+                        { w.new_rows(sense, rhs); }, 2 * rhs.size());
 }
 
 void Relaxation::add_cut(const double rhs, const char sense,
@@ -466,6 +597,10 @@ void Relaxation::add_cut(const double rhs, const char sense,
 
     if (rval)
         throw cpx_err(rval, "CPXaddrows");
+
+    simpl_p->log_change([rhs, sense, rmatind, rmatval](Relaxation &w)
+                        { w.add_cut(rhs, sense, rmatind, rmatval); },
+                        2 * rmatind.size());
 }
 
 void Relaxation::add_cut(const SparseRow &sp_row)
@@ -485,13 +620,45 @@ void Relaxation::add_cuts(const vector<double> &rhs,
                           (char **) NULL, (char **) NULL);
     if (rval)
         throw cpx_err(rval, "CPXaddrows");
+
+    simpl_p->log_change([rhs, sense, rmatbeg, rmatind, rmatval](Relaxation &w)
+                        { w.add_cuts(rhs, sense, rmatbeg, rmatind, rmatval); },
+                        3 * rhs.size() + 2 * rmatind.size());
+}
+
+/** The rows of \p batch are added with a single call to CPXaddrows. */
+void Relaxation::add_cuts(const RowBatch &batch)
+{
+    if (batch.empty())
+        return;
+
+    int rval = CPXaddrows(simpl_p->env, simpl_p->lp, 0, batch.size(),
+                          batch.rmatind.size(), &batch.rhs[0],
+                          &batch.sense[0], &batch.rmatbeg[0],
+                          batch.rmatind.data(), batch.rmatval.data(),
+                          (char **) NULL, (char **) NULL);
+    if (rval)
+        throw cpx_err(rval, "CPXaddrows");
+
+    simpl_p->log_change([batch](Relaxation &w) { w.add_cuts(batch); },
+                        3 * batch.size() + 2 * batch.rmatind.size());
 }
 
 void Relaxation::del_set_rows(std::vector<int> &delstat)
 {
+    vector<int> del_copy;
+    if (!simpl_p->sb_workers.empty())
+        del_copy = delstat;
+
     int rval = CPXdelsetrows(simpl_p->env, simpl_p->lp, &delstat[0]);
     if (rval)
         throw cpx_err(rval, "CPXdelsetrows");
+
+    simpl_p->log_change([del_copy](Relaxation &w)
+                        {
+                            vector<int> del = del_copy;
+                            w.del_set_rows(del);
+                        }, del_copy.size());
 }
 
 void Relaxation::get_row_infeas(const std::vector<double> &x,
@@ -532,13 +699,48 @@ void Relaxation::add_col(const double objval, const vector<int> &indices,
                           &lb, &ub, (char **) NULL);
     if (rval)
         throw cpx_err(rval, "CPXaddcols");
+
+    simpl_p->log_change([objval, indices, coeffs, lb, ub](Relaxation &w)
+                        { w.add_col(objval, indices, coeffs, lb, ub); },
+                        2 * indices.size() + 3);
+}
+
+void Relaxation::add_cols(const vector<double> &objval,
+                          const vector<int> &cmatbeg,
+                          const vector<int> &cmatind,
+                          const vector<double> &cmatval,
+                          const vector<double> &lb,
+                          const vector<double> &ub)
+{
+    int rval = CPXaddcols(simpl_p->env, simpl_p->lp, cmatbeg.size(),
+                          cmatind.size(), &objval[0], &cmatbeg[0],
+                          &cmatind[0], &cmatval[0], &lb[0], &ub[0],
+                          (char **) NULL);
+    if (rval)
+        throw cpx_err(rval, "CPXaddcols");
+
+    simpl_p->log_change([objval, cmatbeg, cmatind, cmatval, lb,
+                         ub](Relaxation &w)
+                        { w.add_cols(objval, cmatbeg, cmatind, cmatval, lb,
+                                     ub); },
+                        4 * objval.size() + 2 * cmatind.size());
 }
 
 void Relaxation::del_set_cols(std::vector<int> &delstat)
 {
+    vector<int> del_copy;
+    if (!simpl_p->sb_workers.empty())
+        del_copy = delstat;
+
     int rval = CPXdelsetcols(simpl_p->env, simpl_p->lp, &delstat[0]);
     if (rval)
         throw cpx_err(rval, "CPXdelsetcols");
+
+    simpl_p->log_change([del_copy](Relaxation &w)
+                        {
+                            vector<int> del = del_copy;
+                            w.del_set_cols(del);
+                        }, del_copy.size());
 }
 
 void Relaxation::get_base(vector<int> &colstat,
@@ -663,6 +865,55 @@ void Relaxation::dual_opt()
         throw cpx_err(rval, "CPXdualopt");
 }
 
+/**
+ * With a ThreadPolicy of one thread, as set by default, this is the same as
+ * primal_opt, since CPLEX simplex pivoting is sequential. Otherwise the
+ * threads and parallel mode of the policy are used for this call only, with
+ * the barrier method (followed by crossover to an optimal basis) or
+ * concurrent optimization, which can make use of them. Callers should use
+ * this for long optimizations such as those at the root or after adding
+ * many columns, where the extra threads pay off.
+ */
+void Relaxation::full_opt()
+{
+    const ThreadPolicy &policy = simpl_p->policy;
+    using Mode = ThreadPolicy::Mode;
+
+    if (policy.threads == 1) {
+        primal_opt();
+        return;
+    }
+
+    int par_mode = (policy.mode == Mode::Deterministic ?
+                    CPX_PARALLEL_DETERMINISTIC : CPX_PARALLEL_OPPORTUNISTIC);
+    int method = (policy.mode == Mode::Concurrent ?
+                  CPX_ALG_CONCURRENT : CPX_ALG_BARRIER);
+
+    CPXintParamGuard threads(CPX_PARAM_THREADS, policy.threads, simpl_p->env,
+                             "full_opt thread count");
+    CPXintParamGuard parallel(CPX_PARAM_PARALLELMODE, par_mode, simpl_p->env,
+                              "full_opt parallel mode");
+    CPXintParamGuard lp_method(CPX_PARAM_LPMETHOD, method, simpl_p->env,
+                               "full_opt method");
+
+    int rval = CPXlpopt(simpl_p->env, simpl_p->lp);
+    if (rval)
+        throw cpx_err(rval, "CPXlpopt");
+}
+
+/**
+ * @param policy the policy, with a nonnegative thread count.
+ * @remark Relaxations made by clone do not inherit the policy, since clones
+ * are meant to be optimized on threads of their own.
+ */
+void Relaxation::set_thread_policy(const ThreadPolicy &policy)
+{
+    if (policy.threads < 0)
+        throw runtime_error("Negative thread count in ThreadPolicy");
+
+    simpl_p->policy = policy;
+}
+
 /**
  * This function computes a primal non-degenerate pivot by setting an objective
  * value lower limit.
@@ -751,6 +1002,15 @@ void Relaxation::primal_recover()
         throw cpx_err(rval, "CPXsetlpcallbackfunc undoing cb");
 }
 
+/**
+ * @returns the CPLEX CPX_ALG_* value of the method that produced the resident
+ * solution; for concurrent optimization, the method that finished first.
+ */
+int Relaxation::opt_method() const
+{
+    return CPXgetmethod(simpl_p->env, simpl_p->lp);
+}
+
 double Relaxation::get_objval() const
 {
     double result = std::numeric_limits<double>::max();
@@ -863,6 +1123,48 @@ vector<double> Relaxation::redcosts(int begin, int end) const
                     end);
 }
 
+/**
+ * Workers already in sb_workers are brought up to date by replaying journal,
+ * unless the journal is larger than the problem itself, in which case they
+ * are discarded and recloned.
+ * @param[in] master the Relaxation which owns this solver_impl.
+ * @param[in] count the number of workers needed.
+ */
+void Relaxation::solver_impl::sync_workers(const Relaxation &master, int count)
+{
+    if (!sb_workers.empty()) {
+        std::size_t probsize = CPXgetnumnz(env, lp) + master.num_rows() +
+                               master.num_cols();
+
+        if (journal_size > probsize) {
+            sb_workers.clear();
+        } else {
+            try {
+                for (Relaxation &w : sb_workers)
+                    for (auto &change : journal)
+                        change(w);
+            } catch (const exception &e) {
+                cerr << e.what() << ", recloning worker LPs\n";
+                sb_workers.clear();
+            }
+
+            for (const Relaxation &w : sb_workers)
+                if (w.num_rows() != master.num_rows() ||
+                    w.num_cols() != master.num_cols()) {
+                    cerr << "Worker LP out of sync, recloning\n";
+                    sb_workers.clear();
+                    break;
+                }
+        }
+    }
+
+    journal.clear();
+    journal_size = 0;
+
+    while (sb_workers.size() < static_cast<std::size_t>(count))
+        sb_workers.emplace_back(master.clone());
+}
+
 /**
  * @param[in] tour_vec the resident best tour
  * @param[in] colstat the column basis for \p tour_vec
@@ -877,6 +1179,10 @@ vector<double> Relaxation::redcosts(int begin, int end) const
  * `indices[i]` to disagree with `tour_entry[indices[i]]`.
  * @param[in] itlim the maximum number of simplex iterations to do.
  * @param[in] upperbound the length of \p tour_vec.
+ * @remark If CMR_USE_OMP is defined, the candidates are divided dynamically
+ * among one worker LP per thread, each warm starting from \p colstat and
+ * \p rowstat. The workers are kept between calls, and only the changes made
+ * to this Relaxation since the last call are applied to them.
  */
 void Relaxation::primal_strong_branch(const vector<double> &tour_vec,
                                       const vector<int> &colstat,
@@ -887,97 +1193,181 @@ void Relaxation::primal_strong_branch(const vector<double> &tour_vec,
                                       vector<Basis> &contra_bases,
                                       int itlim, double upperbound)
 {
-    using EstStat = Estimate::Stat;
-
-    CPXintParamGuard per_ind(CPX_PARAM_PERIND, 0, simpl_p->env,
-                             "primal_strong_branch perturb");
+    runtime_error err("Problem in Relaxation::primal_strong_branch.");
 
-    CPXintParamGuard price_ind(CPX_PARAM_PPRIIND, CPX_PPRIIND_STEEP,
-                               simpl_p->env, "primal_strong_branch pricing");
+    int candcount = indices.size();
 
     down_est.clear();
     up_est.clear();
-    down_est.reserve(indices.size());
-    up_est.reserve(indices.size());
+    down_est.resize(candcount);
+    up_est.resize(candcount);
+
+    if (candcount == 0)
+        return;
 
     bool have_bases = false;
     if (!contra_bases.empty())
         have_bases = true;
     else
-        contra_bases.reserve(indices.size());
+        contra_bases.resize(candcount);
 
-    using ClampPair = std::pair<char, double>;
+#if !(CMR_USE_OMP)
+    {
+        CPXintParamGuard per_ind(CPX_PARAM_PERIND, 0, simpl_p->env,
+                                 "primal_strong_branch perturb");
 
-    std::array<ClampPair, 2> clamps{ClampPair('U', 0.0), ClampPair('L', 1.0)};
+        CPXintParamGuard price_ind(CPX_PARAM_PPRIIND, CPX_PPRIIND_STEEP,
+                                   simpl_p->env,
+                                   "primal_strong_branch pricing");
 
-    for (int i = 0; i < indices.size(); ++i) {
-        int ind = indices[i];
-        for (ClampPair &cp : clamps) {
-            char sense = cp.first;
-            double clamp_bound = cp.second;
-            double unclamp_bound = 1.0 - cp.second;
+        for (int i = 0; i < candcount; ++i)
+            sb_candidate(tour_vec, colstat, rowstat, indices[i],
+                         down_est[i], up_est[i], contra_bases[i],
+                         have_bases, itlim, upperbound);
+    }
+#else
+    int workcount = std::min(omp_get_max_threads(), candcount);
 
-            tighten_bound(ind, sense, clamp_bound);
+    try {
+        simpl_p->sync_workers(*this, workcount);
+    } CMR_CATCH_PRINT_THROW("syncing worker LPs", err);
 
-            if (tour_vec[ind] == clamp_bound) {
-                copy_start(tour_vec);
-                factor_basis();
-            } else {
-                if (!have_bases) {
-                    copy_base(colstat, rowstat);
-                    primal_recover();
-                    // cout << "P feas after prim recover: "
-                    //      << primal_feas() << ", "
-                    //      << it_count() << " iterations\n";
-                    if (!primal_feas())
-                        cout << "Infeasible with stat "
-                             << CPXgetstat(simpl_p->env, simpl_p->lp) << "\n";
-                    contra_bases.emplace_back(basis_obj());
-                } else {
-                    copy_base(contra_bases[i].colstat,
-                              contra_bases[i].rowstat);
-                    factor_basis();
+    vector<Relaxation> &workers = simpl_p->sb_workers;
+    std::atomic<bool> caught_exception(false);
+
+    #pragma omp parallel num_threads(workcount)
+    {
+        Relaxation &worker = workers[omp_get_thread_num()];
+
+        #pragma omp for schedule(dynamic, 1)
+        for (int i = 0; i < candcount; ++i) {
+            if (caught_exception)
+                continue;
+
+            try {
+                CPXintParamGuard per_ind(CPX_PARAM_PERIND, 0,
+                                         worker.simpl_p->env,
+                                         "primal_strong_branch perturb");
+
+                CPXintParamGuard price_ind(CPX_PARAM_PPRIIND,
+                                           CPX_PPRIIND_STEEP,
+                                           worker.simpl_p->env,
+                                           "primal_strong_branch pricing");
+
+                worker.sb_candidate(tour_vec, colstat, rowstat, indices[i],
+                                    down_est[i], up_est[i], contra_bases[i],
+                                    have_bases, itlim, upperbound);
+            } catch (const exception &e) {
+                #pragma omp critical
+                {
+                    cerr << e.what() << " in strong branch candidate "
+                         << indices[i] << "\n";
+                    caught_exception = true;
                 }
             }
+        }
+    }
 
-            CPXlongParamGuard it_lim(CPX_PARAM_ITLIM, itlim, simpl_p->env,
-                                     "primal_strong_branch it lim");
+    if (caught_exception)
+        throw err;
+#endif
 
-            primal_opt();
+    copy_start(tour_vec);
+    factor_basis();
+}
+
+/**
+ * Evaluates the down and up clamps of column \p ind, starting from the tour
+ * solution for the clamp agreeing with the tour, and from a contra basis for
+ * the other.
+ * @param[in] tour_vec the tour solution vector.
+ * @param[in] colstat the column basis for the tour.
+ * @param[in] rowstat the row basis for the tour.
+ * @param[in] ind the column to be clamped.
+ * @param[out] down the Estimate for clamping \p ind to zero.
+ * @param[out] up the Estimate for clamping \p ind to one.
+ * @param[in,out] contra_base the basis used for the clamp contradicting the
+ * tour. If \p have_base is false, it is computed by primal recovery from the
+ * tour basis, and stored here.
+ * @param[in] have_base whether \p contra_base is already known.
+ * @param[in] itlim the pivot limit for each clamp.
+ * @param[in] upperbound the objective value of the best tour.
+ * @remark This modifies only this Relaxation, so distinct clones may evaluate
+ * candidates concurrently.
+ */
+void Relaxation::sb_candidate(const vector<double> &tour_vec,
+                              const vector<int> &colstat,
+                              const vector<int> &rowstat,
+                              int ind, Estimate &down, Estimate &up,
+                              Basis &contra_base, bool have_base,
+                              int itlim, double upperbound)
+{
+    using EstStat = Estimate::Stat;
+    using ClampPair = std::pair<char, double>;
 
-            int solstat = CPXgetstat(simpl_p->env, simpl_p->lp);
-            double objval = get_objval();
-            Estimate est(objval);
+    std::array<ClampPair, 2> clamps{ClampPair('U', 0.0), ClampPair('L', 1.0)};
 
-            if (solstat == CPX_STAT_INFEASIBLE) {
-                est.sol_stat = EstStat::Infeas;
-                est.value = upperbound;
-                util::ptr_reset(est.sb_base, basis_obj());
-            } else if (solstat != CPX_STAT_ABORT_IT_LIM &&
-                       solstat != CPX_STAT_OPTIMAL &&
-                       solstat != CPX_STAT_OPTIMAL_INFEAS) {
-                throw cpx_err(solstat,
-                              clamp_bound == 0.0 ?
-                              "CPXgetstat in down clamp" :
-                              "CPXgetstat in up clamp");
+    for (ClampPair &cp : clamps) {
+        char sense = cp.first;
+        double clamp_bound = cp.second;
+        double unclamp_bound = 1.0 - cp.second;
+
+        tighten_bound(ind, sense, clamp_bound);
+
+        if (tour_vec[ind] == clamp_bound) {
+            copy_start(tour_vec);
+            factor_basis();
+        } else {
+            if (!have_base) {
+                copy_base(colstat, rowstat);
+                primal_recover();
+                // cout << "P feas after prim recover: "
+                //      << primal_feas() << ", "
+                //      << it_count() << " iterations\n";
+                if (!primal_feas())
+                    cout << "Infeasible with stat "
+                         << CPXgetstat(simpl_p->env, simpl_p->lp) << "\n";
+                contra_base = basis_obj();
+            } else {
+                copy_base(contra_base.colstat, contra_base.rowstat);
+                factor_basis();
             }
+        }
 
-            if (solstat == CPX_STAT_OPTIMAL) {
-                if (upperbound  <= objval || (upperbound - objval) <= 0.9) {
-                    est.sol_stat = EstStat::Prune;
-                    util::ptr_reset(est.sb_base, basis_obj());
-                }
+        CPXlongParamGuard it_lim(CPX_PARAM_ITLIM, itlim, simpl_p->env,
+                                 "primal_strong_branch it lim");
+
+        primal_opt();
+
+        int solstat = CPXgetstat(simpl_p->env, simpl_p->lp);
+        double objval = get_objval();
+        Estimate est(objval);
+
+        if (solstat == CPX_STAT_INFEASIBLE) {
+            est.sol_stat = EstStat::Infeas;
+            est.value = upperbound;
+            util::ptr_reset(est.sb_base, basis_obj());
+        } else if (solstat != CPX_STAT_ABORT_IT_LIM &&
+                   solstat != CPX_STAT_OPTIMAL &&
+                   solstat != CPX_STAT_OPTIMAL_INFEAS) {
+            throw cpx_err(solstat,
+                          clamp_bound == 0.0 ?
+                          "CPXgetstat in down clamp" :
+                          "CPXgetstat in up clamp");
+        }
+
+        if (solstat == CPX_STAT_OPTIMAL) {
+            if (upperbound  <= objval || (upperbound - objval) <= 0.9) {
+                est.sol_stat = EstStat::Prune;
+                util::ptr_reset(est.sb_base, basis_obj());
             }
+        }
 
-            vector<Estimate> &est_vec = clamp_bound == 0.0 ? down_est : up_est;
-            est_vec.push_back(std::move(est));
+        Estimate &est_ref = clamp_bound == 0.0 ? down : up;
+        est_ref = std::move(est);
 
-            tighten_bound(ind, sense, unclamp_bound);
-        }
+        tighten_bound(ind, sense, unclamp_bound);
     }
-
-    copy_start(tour_vec);
-    factor_basis();
 }
 
 /**
@@ -995,6 +1385,9 @@ void Relaxation::tighten_bound(int index, char sense, double val)
                              &val);
     if (rval)
         throw cpx_err(rval, "CPXtightenbds");
+
+    simpl_p->log_change([index, sense, val](Relaxation &w)
+                        { w.tighten_bound(index, sense, val); }, 3);
 }
 
 void Relaxation::change_obj(const int index, const double val)
@@ -1002,6 +1395,9 @@ void Relaxation::change_obj(const int index, const double val)
     int rval = CPXchgobj(simpl_p->env, simpl_p->lp, 1, &index, &val);
     if (rval)
         throw cpx_err(rval, "CPXchgobj");
+
+    simpl_p->log_change([index, val](Relaxation &w)
+                        { w.change_obj(index, val); }, 2);
 }
 
 void Relaxation::init_mir_data(Sep::MIRgroup &mir_data)
@@ -0,0 +1,101 @@
+#include "lp_util.hpp"
+
+#include <stdexcept>
+
+using std::vector;
+using std::runtime_error;
+
+namespace CMR {
+namespace LP {
+
+/**
+ * @throws std::runtime_error if \p base has a status outside of BStat.
+ */
+PackedBasis::PackedBasis(const Basis &base)
+    : ccount(base.colstat.size()), rcount(base.rowstat.size()),
+      bits((ccount + rcount + 3) / 4, 0)
+{
+    int i = 0;
+
+    for (const vector<int> *stats : {&base.colstat, &base.rowstat})
+        for (int st : *stats) {
+            if (st < BStat::AtLower || st > BStat::FreeSuper)
+                throw runtime_error("PackedBasis got bad basis status");
+            bits[i / 4] |= st << (2 * (i % 4));
+            ++i;
+        }
+}
+
+Basis PackedBasis::unpack() const
+{
+    Basis result;
+
+    result.colstat.resize(ccount);
+    result.rowstat.resize(rcount);
+
+    for (int i = 0; i < ccount; ++i)
+        result.colstat[i] = stat(i);
+    for (int i = 0; i < rcount; ++i)
+        result.rowstat[i] = stat(ccount + i);
+
+    return result;
+}
+
+/**
+ * An empty \p base gives an empty BasisDelta.
+ */
+BasisDelta::BasisDelta(const Basis &base, PackedBasis::Ptr ref_)
+{
+    if (base.empty())
+        return;
+
+    int ccount = base.colstat.size();
+    int rcount = base.rowstat.size();
+
+    if (!ref_ || ref_->col_count() != ccount || ref_->row_count() != rcount) {
+        ref = std::make_shared<const PackedBasis>(base);
+        return;
+    }
+
+    ref = std::move(ref_);
+
+    for (int i = 0; i < ccount + rcount; ++i) {
+        int st = i < ccount ? base.colstat[i] : base.rowstat[i - ccount];
+        if (st < BStat::AtLower || st > BStat::FreeSuper)
+            throw runtime_error("BasisDelta got bad basis status");
+        if (st != ref->stat(i))
+            diffs.push_back((static_cast<unsigned>(i) << 2) | st);
+    }
+
+    diffs.shrink_to_fit();
+}
+
+void BasisDelta::clear()
+{
+    ref.reset();
+    vector<unsigned>().swap(diffs);
+}
+
+Basis BasisDelta::unpack() const
+{
+    if (!ref)
+        return Basis();
+
+    Basis result = ref->unpack();
+    int ccount = ref->col_count();
+
+    for (unsigned d : diffs) {
+        int i = d >> 2;
+        int st = d & 3;
+
+        if (i < ccount)
+            result.colstat[i] = st;
+        else
+            result.rowstat[i - ccount] = st;
+    }
+
+    return result;
+}
+
+}
+}
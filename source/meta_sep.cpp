@@ -45,12 +45,34 @@ MetaCuts::MetaCuts(const ExternalCuts &EC_,
                    Data::SupportGroup &s_dat) try
     : EC(EC_), core_edges(core_edges_), active_tour(active_tour_),
       supp_data(s_dat),
-      TG(),
+      own_TG(), TG(own_TG),
       perm_elist(s_dat.support_elist)
 {
     if (filter_primal)
-        TG = TourGraph(active_tour.edges(), core_edges,
-                       active_tour.tour_perm());
+        own_TG = TourGraph(active_tour.edges(), core_edges,
+                           active_tour.tour_perm());
+    for (int i = 0; i < perm_elist.size(); ++i)
+        perm_elist[i] = active_tour.tour_perm()[perm_elist[i]];
+} catch (const exception &e) {
+    cerr << e.what() << endl;
+    throw runtime_error("MetaCuts constructor failed");
+}
+
+/**
+ * As above, but the TourGraph for primal filtering is taken from \p tg_cache
+ * rather than built from scratch.
+ */
+MetaCuts::MetaCuts(const ExternalCuts &EC_,
+                   const vector<Graph::Edge> &core_edges_,
+                   const LP::ActiveTour &active_tour_,
+                   Data::SupportGroup &s_dat,
+                   TourGraphCache &tg_cache) try
+    : EC(EC_), core_edges(core_edges_), active_tour(active_tour_),
+      supp_data(s_dat),
+      own_TG(), TG(tg_cache.get(active_tour_.edges(), core_edges_,
+                                active_tour_.tour_perm())),
+      perm_elist(s_dat.support_elist)
+{
     for (int i = 0; i < perm_elist.size(); ++i)
         perm_elist[i] = active_tour.tour_perm()[perm_elist[i]];
 } catch (const exception &e) {
@@ -360,8 +382,8 @@ bool MetaCuts::price_combs(bool tighten)
             continue;
 
         double slack = -rhs;
-        for (const Clique::Ptr &clq_ref : H.get_cliques())
-            slack += clique_vals[*clq_ref];
+        for (CliqueId id : H.get_cliques())
+            slack += clique_vals[id];
 
         if (slack < tolerance) {
             try { interest_combs.push_back(it); }
@@ -409,7 +431,7 @@ bool MetaCuts::attempt_sep()
 
 void MetaCuts::price_cliques()
 {
-    try { clique_vals.reserve(EC.get_cbank().size()); }
+    try { clique_vals.assign(EC.get_cbank().id_bound(), 0.0); }
     catch (const exception &e) {
         cerr << e.what() << " reserving clique_vals" << endl;
         throw runtime_error("MetaCuts::price_cliques failed");
@@ -425,20 +447,22 @@ void MetaCuts::price_cliques()
 
     int marker = 0;
 
-    for (CliqueBank::ConstItr it = lp_cliques.begin();
-         it != lp_cliques.end(); ++it) {
-        const Clique &clq = it->first;
+    for (CliqueId id = 0; id < lp_cliques.id_bound(); ++id) {
+        if (!lp_cliques.live(id))
+            continue;
+
+        SegRange segs = lp_cliques.seg_list(id);
         double lp_val = 0.0;
 
         ++marker;
 
-        for (const Segment &seg : clq.seg_list())
+        for (const Segment &seg : segs)
             for (int k = seg.start; k <= seg.end; ++k) {
                 int node = def_tour[k];
                 lp_nodelist[node].mark = marker;
             }
 
-        for (const Segment &seg : clq.seg_list())
+        for (const Segment &seg : segs)
             for (int k = seg.start; k <= seg.end; ++k) {
                 int node = def_tour[k];
 
@@ -446,7 +470,7 @@ void MetaCuts::price_cliques()
                     if (lp_nodelist[a.other_end].mark != marker)
                         lp_val += a.val;
             }
-        clique_vals[clq] = lp_val;
+        clique_vals[id] = lp_val;
     }
 }
 
@@ -36,6 +36,16 @@ f64 Pricer::exact_lb(bool full)
     return exact_lb(full, priced_edges);
 }
 
+/**
+ * @param full if true, price every edge of the complete graph, otherwise just
+ * the edges of the core graph.
+ * @param[out] priced_edges if \p full is false, the core edges with their
+ * reduced costs, indexed as in the core graph. If \p full is true, only the
+ * edges with negative reduced cost, since the complete graph is priced in
+ * blocks of at most #full_lb_batch node pairs and never stored in full.
+ * @returns a lower bound on the length of any tour, computed in Fixed64
+ * arithmetic.
+ */
 f64 Pricer::exact_lb(bool full,
                      vector<PrEdge<f64>> &priced_edges)
 {
@@ -45,10 +55,8 @@ f64 Pricer::exact_lb(bool full,
 
     runtime_error err("Problem in Pricer::exact_lb");
 
-    try {
-        ex_duals = util::make_unique<LP::DualGroup<f64>>(true, core_lp,
-                                                         ext_cuts);
-    } CMR_CATCH_PRINT_THROW("constructing exact DualGroup", err);
+    try { refresh_duals(ex_duals, true); }
+    CMR_CATCH_PRINT_THROW("constructing exact DualGroup", err);
 
     priced_edges.clear();
 
@@ -79,30 +87,52 @@ f64 Pricer::exact_lb(bool full,
                     ex_pi[i] = 0.0;
         }
 
-    f64 pi_sum{0.0};
+    // weight each dual by its righthand side, two for the degree equations,
+    // taking runs of cuts with equal righthand side together
+    vector<f64> rhs_pi;
 
-    for (int i = 0; i < numrows; ++i)
-        util::add_mult(pi_sum, ex_pi[i], rhs_vec[i]);
+    try { rhs_pi.resize(numrows, f64{0.0}); }
+    CMR_CATCH_PRINT_THROW("allocating weighted duals", err);
 
+    util::add_mult(rhs_pi.data(), ex_pi.data(), 2, ncount);
 
-    vector<PrEdge<f64>> target_edges;
+    for (int i = ncount; i < numrows;) {
+        int run_end = i + 1;
+        while (run_end < numrows && rhs_vec[run_end] == rhs_vec[i])
+            ++run_end;
 
-    if (full) {
-        for (int i = 0; i < ncount; ++i)
-            for (int j = 0; j < ncount; ++j)
-                target_edges.emplace_back(i, j);
-    } else {
-        for (const Graph::Edge &e : core_graph.get_edges())
-            target_edges.emplace_back(e.end[0], e.end[1]);
+        util::add_mult(rhs_pi.data() + i, ex_pi.data() + i,
+                       static_cast<int>(rhs_vec[i]), run_end - i);
+        i = run_end;
     }
 
-    price_edges(target_edges, ex_duals, true);
+    f64 pi_sum = util::sum(rhs_pi.data(), numrows);
 
     f64 rc_sum{0.0};
 
-    for (const PrEdge<f64> &e : target_edges)
-        if (e.redcost < 0.0)
-            rc_sum -= e.redcost;
+    if (full) {
+        try {
+            rc_sum = full_rc_sum(priced_edges);
+        } CMR_CATCH_PRINT_THROW("streaming full graph reduced costs", err);
+
+        return pi_sum - rc_sum;
+    }
+
+    vector<PrEdge<f64>> target_edges;
+
+    try {
+        price_core_edges(target_edges, ex_duals);
+    } CMR_CATCH_PRINT_THROW("pricing core edges", err);
+
+    vector<f64> neg_rcs;
+
+    try {
+        for (const PrEdge<f64> &e : target_edges)
+            if (e.redcost < 0.0)
+                neg_rcs.push_back(e.redcost);
+    } CMR_CATCH_PRINT_THROW("gathering negative reduced costs", err);
+
+    rc_sum -= util::sum(neg_rcs.data(), neg_rcs.size());
 
     f64 bound = pi_sum - rc_sum;
 
@@ -111,6 +141,78 @@ f64 Pricer::exact_lb(bool full,
     return bound;
 }
 
+/**
+ * Walks the node pairs `i < j` of the complete graph in lexicographic order,
+ * pricing them in blocks of at most #full_lb_batch edges with #ex_duals. Only
+ * the running sum and the negative reduced cost edges outlive a block, so
+ * memory use is bounded by the block size rather than the square of the
+ * node count.
+ * @param[out] neg_edges the edges with negative reduced cost.
+ * @returns the sum of the absolute values of the negative reduced costs.
+ */
+f64 Pricer::full_rc_sum(vector<PrEdge<f64>> &neg_edges)
+{
+    runtime_error err("Problem in Pricer::full_rc_sum");
+
+    if (!ex_duals)
+        throw runtime_error("Tried to stream full graph without exact duals.");
+
+    int ncount = inst.node_count();
+    long pair_count = (static_cast<long>(ncount) * (ncount - 1)) / 2;
+    long batch = std::min(pair_count, static_cast<long>(full_lb_batch));
+
+    if (batch <= 0)
+        batch = 1;
+
+    f64 rc_sum{0.0};
+    vector<PrEdge<f64>> block;
+    vector<f64> neg_rcs;
+
+    neg_edges.clear();
+
+    try { block.reserve(batch); }
+    CMR_CATCH_PRINT_THROW("reserving price block", err);
+
+    int i = 0;
+    int j = 1;
+    int blockcount = 0;
+
+    while (i < ncount - 1) {
+        block.clear();
+
+        while (i < ncount - 1 && block.size() < batch) {
+            block.emplace_back(i, j);
+            if (++j == ncount) {
+                ++i;
+                j = i + 1;
+            }
+        }
+
+        ++blockcount;
+
+        try {
+            price_edges(block, ex_duals, true);
+        } CMR_CATCH_PRINT_THROW("pricing block of edges", err);
+
+        try {
+            neg_rcs.clear();
+            for (const PrEdge<f64> &e : block)
+                if (e.redcost < 0.0) {
+                    neg_rcs.push_back(e.redcost);
+                    neg_edges.push_back(e);
+                }
+        } CMR_CATCH_PRINT_THROW("keeping negative rc edges", err);
+
+        rc_sum -= util::sum(neg_rcs.data(), neg_rcs.size());
+    }
+
+    if (verbose)
+        cout << "\tPriced " << pair_count << " edges in " << blockcount
+             << " blocks, " << neg_edges.size() << " with negative rc" << endl;
+
+    return rc_sum;
+}
+
 void Pricer::elim_edges(bool make_opt)
 {
     runtime_error err("Problem in Pricer::elim_edges.");
@@ -118,7 +220,7 @@ void Pricer::elim_edges(bool make_opt)
     if (make_opt) {
         double ot = util::zeit();
         cout << "Optimizing before elimination...";
-        try { core_lp.primal_opt(); } CMR_CATCH_PRINT_THROW("optimizing", err);
+        try { core_lp.full_opt(); } CMR_CATCH_PRINT_THROW("optimizing", err);
         cout << "obj val " << core_lp.get_objval() << " in "
              << (util::zeit() - ot) << "s" << endl;
     }
@@ -143,9 +245,8 @@ void Pricer::elim_edges(bool make_opt)
     if (verbose)
         cout << "\tElimination cutoff " << cutoff << endl;
 
-    try {
-        util::ptr_reset(ex_duals, true, core_lp, core_lp.external_cuts());
-    } CMR_CATCH_PRINT_THROW("getting exact duals", err);
+    try { refresh_duals(ex_duals, true); }
+    CMR_CATCH_PRINT_THROW("getting exact duals", err);
 
     vector<int> col_delset;
     int ecount = core_graph.edge_count();
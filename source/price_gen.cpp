@@ -115,10 +115,8 @@ ScanStat Pricer::gen_edges(LP::PivType piv_stat, bool try_elim)
 
     edge_hash.clear();
 
-    try {
-        reg_duals = util::make_unique<LP::DualGroup<double>>(false, core_lp,
-                                                             ext_cuts);
-    } CMR_CATCH_PRINT_THROW("populating clique pi", err);
+    try { refresh_duals(reg_duals, false); }
+    CMR_CATCH_PRINT_THROW("populating clique pi", err);
 
     edgegen_impl *current_eg;
 
@@ -223,7 +221,7 @@ ScanStat Pricer::gen_edges(LP::PivType piv_stat, bool try_elim)
                 num_added = add_batch.size();
                 total_added += num_added;
                 core_lp.add_edges(add_batch, true);
-                core_lp.primal_opt();
+                core_lp.full_opt();
                 new_objval = core_lp.get_objval();
             } CMR_CATCH_PRINT_THROW("adding edges to lp and optimizing", err);
 
@@ -233,7 +231,7 @@ ScanStat Pricer::gen_edges(LP::PivType piv_stat, bool try_elim)
                 result = ScanStat::Full;
 
             try {
-                reg_duals.reset();
+                refresh_duals(reg_duals, false);
                 price_edges(edge_q, reg_duals, true);
             } CMR_CATCH_PRINT_THROW("getting new duals and re-pricing", err);
 
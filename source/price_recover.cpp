@@ -56,10 +56,8 @@ bool Pricer::feas_recover()
     } else if (verbose)
         cout << "Primal optimized with infeasible LP" << endl;
 
-    try {
-        reg_duals = util::make_unique<LP::DualGroup<double>>(false, core_lp,
-                                                             ext_cuts);
-    } CMR_CATCH_PRINT_THROW("populating clique pi", err);
+    try { refresh_duals(reg_duals, false); }
+    CMR_CATCH_PRINT_THROW("populating clique pi", err);
 
     edge_hash.clear();
 
@@ -129,7 +127,7 @@ bool Pricer::feas_recover()
                 return true;
 
             try {
-                reg_duals.reset();
+                refresh_duals(reg_duals, false);
                 price_edges(edge_q, reg_duals, false);
             } CMR_CATCH_PRINT_THROW("getting new duals/re-pricing", err);
 
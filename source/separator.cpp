@@ -4,6 +4,7 @@
 #include "simpleDP.hpp"
 #include "blossoms.hpp"
 #include "err_util.hpp"
+#include "config.hpp"
 
 #include <vector>
 #include <stdexcept>
@@ -41,19 +42,129 @@ Separator::Separator(const vector<Graph::Edge> &core_edges_,
 }
 
 /**
- * @warning This method must be called before constructing any any separator
- * that derives from ConcordeSeparator, i.e., SegmentCuts, FastBlossoms,
- * BlockCombs, and ConnectCuts.
+ * As above, but the TourGraph used by Concorde-based separators will be
+ * taken from \p tg_cache_, so it is only rebuilt when the tour or edges
+ * change instead of at every separation call.
  */
-void Separator::set_TG()
+Separator::Separator(const vector<Graph::Edge> &core_edges_,
+                     const LP::ActiveTour &active_tour_,
+                     Data::SupportGroup &suppdata,
+                     Data::KarpPartition &kpart, int seed,
+                     TourGraphCache &tg_cache_)
+    : Separator(core_edges_, active_tour_, suppdata, kpart, seed)
+{
+    tg_cache = &tg_cache_;
+}
+
+/**
+ * @warning This method must be called to get the TourGraph passed to any
+ * separator that derives from ConcordeSeparator, i.e., SegmentCuts,
+ * FastBlossoms, BlockCombs, and ConnectCuts.
+ */
+TourGraph &Separator::tour_graph()
 {
-    TG = TourGraph(active_tour.edges(), core_edges, active_tour.tour_perm());
+    if (tg_cache)
+        return tg_cache->get(active_tour.edges(), core_edges,
+                             active_tour.tour_perm());
+
+    own_TG = TourGraph(active_tour.edges(), core_edges,
+                       active_tour.tour_perm());
+    return own_TG;
 }
 
 bool Separator::segment_sep() try
 {
-    set_TG();
-    SegmentCuts segments(perm_elist, supp_data.support_ecap, TG, seg_q);
+    return segment_find(tour_graph());
+} catch (const exception &e) {
+    cerr << e.what() << "\n";
+    throw runtime_error("Separator::segment_sep failed.");
+}
+
+bool Separator::fast2m_sep() try
+{
+    return fast2m_find(tour_graph());
+} catch (const exception &e) {
+    cerr << e.what() << "\n";
+    throw runtime_error("Separator::fast2m_sep failed.");
+}
+
+bool Separator::blkcomb_sep() try
+{
+    return blkcomb_find(tour_graph());
+} catch (const exception &e) {
+    cerr << e.what() << "\n";
+    throw runtime_error("Separator::blkcomb_sep failed.");
+}
+
+/**
+ * The three routines only read the support graph and tour, so with
+ * CMR_USE_OMP set they are run as parallel tasks. Primal filtering writes
+ * node marks in the TourGraph, so only segment cuts use tour_graph() and the
+ * other two tasks build private copies. The resulting cuts are spliced into
+ * concurrent_q() so that they can be added to the LP and pivoted on at once.
+ * @param do_segment should segment cuts be separated.
+ * @param do_fast2m should fast blossoms be separated.
+ * @param do_blkcomb should block combs be separated.
+ * @returns true iff any of the routines found cuts.
+ */
+bool Separator::concurrent_sep(bool do_segment, bool do_fast2m,
+                               bool do_blkcomb) try
+{
+    const vector<double> &tour_edges = active_tour.edges();
+    const vector<int> &tour_perm = active_tour.tour_perm();
+
+    const bool do_task[3] = {do_segment, do_fast2m, do_blkcomb};
+    bool caught_exception = false;
+
+#if CMR_USE_OMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int task = 0; task < 3; ++task) {
+        if (!do_task[task])
+            continue;
+        try {
+            if (task == 0) {
+                segment_find(tour_graph());
+            } else {
+                TourGraph task_TG(tour_edges, core_edges, tour_perm);
+                if (task == 1)
+                    fast2m_find(task_TG);
+                else
+                    blkcomb_find(task_TG);
+            }
+        } catch (const exception &e) {
+#if CMR_USE_OMP
+            #pragma omp critical
+#endif
+            {
+                cerr << e.what() << " in concurrent task " << task << "\n";
+                caught_exception = true;
+            }
+        }
+    }
+
+    if (caught_exception)
+        throw runtime_error("Concurrent separation failed.");
+
+    conc_q.splice(std::move(seg_q));
+    conc_q.splice(std::move(fast2m_q));
+    conc_q.splice(std::move(blkcomb_q));
+
+    if (verbose) {
+        printf("\t%d concurrent cuts in total\n", conc_q.size());
+        cout << flush;
+    }
+
+    return !conc_q.empty();
+} catch (const exception &e) {
+    cerr << e.what() << "\n";
+    throw runtime_error("Separator::concurrent_sep failed.");
+}
+
+bool Separator::segment_find(TourGraph &tour_graph)
+{
+    SegmentCuts segments(perm_elist, supp_data.support_ecap, tour_graph,
+                         seg_q);
 
     double st = util::zeit();
     bool result = segments.find_cuts();
@@ -65,15 +176,12 @@ bool Separator::segment_sep() try
     }
 
     return result;
-} catch (const exception &e) {
-    cerr << e.what() << "\n";
-    throw runtime_error("Separator::segment_sep failed.");
 }
 
-bool Separator::fast2m_sep() try
+bool Separator::fast2m_find(TourGraph &tour_graph)
 {
-    set_TG();
-    FastBlossoms fast2m(perm_elist, supp_data.support_ecap, TG, fast2m_q);
+    FastBlossoms fast2m(perm_elist, supp_data.support_ecap, tour_graph,
+                        fast2m_q);
 
     fast2m.filter_primal = filter_primal;
 
@@ -83,7 +191,8 @@ bool Separator::fast2m_sep() try
     f2mt = util::zeit() - f2mt;
 
     if (!result) {
-        GHblossoms gh2m(perm_elist, supp_data.support_ecap, TG, fast2m_q);
+        GHblossoms gh2m(perm_elist, supp_data.support_ecap, tour_graph,
+                        fast2m_q);
         gh2mt = util::zeit();
         result = gh2m.find_cuts();
         gh2mt = util::zeit() - gh2mt;
@@ -96,15 +205,12 @@ bool Separator::fast2m_sep() try
     }
 
     return result;
-} catch (const exception &e) {
-    cerr << e.what() << "\n";
-    throw runtime_error("Separator::fast2m_sep failed.");
 }
 
-bool Separator::blkcomb_sep() try
+bool Separator::blkcomb_find(TourGraph &tour_graph)
 {
-    set_TG();
-    BlockCombs blkcomb(perm_elist, supp_data.support_ecap, TG, blkcomb_q);
+    BlockCombs blkcomb(perm_elist, supp_data.support_ecap, tour_graph,
+                       blkcomb_q);
 
     double blkt = util::zeit();
     bool result = blkcomb.find_cuts();
@@ -117,14 +223,10 @@ bool Separator::blkcomb_sep() try
     }
 
     return result;
-} catch (const exception &e) {
-    cerr << e.what() << "\n";
-    throw runtime_error("Separator::blkcomb_sep failed.");
 }
 
 bool Separator::exact2m_sep() try
 {
-    set_TG();
     ExBlossoms ex2m(core_edges, active_tour, supp_data, ex2m_q);
 
     Timer e2mt("Primal blossoms");
@@ -134,12 +236,7 @@ bool Separator::exact2m_sep() try
 
     if (verbose) {
         cout << "\t" << ex2m_q.size() << " primal blossoms" << endl;
-#ifdef CMR_USE_OMP
-        bool cpu = true;
-#else
-        bool cpu = false;
-#endif
-        e2mt.report(cpu);
+        e2mt.report(false);
     }
 
     return result;
@@ -167,7 +264,7 @@ bool Separator::simpleDP_sep() try {
 
 bool Separator::connect_sep() try
 {
-    set_TG();
+    TourGraph &TG = tour_graph();
     ConnectCuts subtour(perm_elist, supp_data.support_ecap, TG, connect_q);
     double cont = util::zeit();
     bool result = subtour.find_cuts();
@@ -186,7 +283,7 @@ bool Separator::connect_sep() try
 
 bool Separator::exsub_sep() try
 {
-    set_TG();
+    TourGraph &TG = tour_graph();
     ExactSub subtour(perm_elist, supp_data.support_ecap, TG, exsub_q);
     double exst = util::zeit();
     bool result = subtour.find_cuts();
@@ -212,7 +309,7 @@ bool Separator::pool_sep(ExternalCuts &EC) try
         return false;
     }
 
-    set_TG();
+    TourGraph &TG = tour_graph();
 
     PoolCuts pool_cuts(perm_elist, supp_data.support_ecap, TG, pool_q,
                        EC.cc_pool, random_seed);
@@ -241,7 +338,7 @@ bool Separator::tighten_pool(ExternalCuts &EC) try
         return false;
     }
 
-    set_TG();
+    TourGraph &TG = tour_graph();
 
     PoolCuts pool_cuts(perm_elist, supp_data.support_ecap, TG, pool_q,
                        EC.cc_pool, random_seed);
@@ -264,7 +361,7 @@ bool Separator::tighten_pool(ExternalCuts &EC) try
 
 bool Separator::consec1_sep(ExternalCuts &EC) try
 {
-    set_TG();
+    TourGraph &TG = tour_graph();
 
     PoolCuts pool_cuts(perm_elist, supp_data.support_ecap, TG, con1_q,
                        EC.cc_pool, random_seed);
@@ -293,7 +390,7 @@ bool Separator::pool_tour_tight(ExternalCuts &EC) try
         return false;
     }
 
-    set_TG();
+    TourGraph &TG = tour_graph();
 
     PoolCuts pool_cuts(perm_elist, supp_data.support_ecap, TG, pool_q,
                        EC.cc_pool, random_seed);
@@ -315,7 +412,7 @@ bool Separator::pool_tour_tight(ExternalCuts &EC) try
 
 bool Separator::local_sep(int chunk_sz, bool sphere) try
 {
-    set_TG();
+    TourGraph &TG = tour_graph();
 
     LocalCuts local_cuts(perm_elist, supp_data.support_ecap, TG, local_q,
                          random_seed);
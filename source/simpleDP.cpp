@@ -4,15 +4,20 @@
 #include "timer.hpp"
 #include "config.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <stdexcept>
+#include <vector>
 
 using std::cout;
 using std::cerr;
 using std::endl;
 
 using std::unique_ptr;
+using std::vector;
 
 using std::runtime_error;
 using std::exception;
@@ -32,13 +37,42 @@ Sep::SimpleDP::SimpleDP(Data::KarpPartition &_kpart,
                         Data::SupportGroup &supp_dat,
                         Sep::CutQueue<dominoparity> &_dp_q,
                         int seed) try :
-    candidates(active_tour, supp_dat), kpart(_kpart), dp_q(_dp_q),
-    random_seed(seed)
+    act_tour(active_tour), candidates(active_tour, supp_dat), kpart(_kpart),
+    dp_q(_dp_q), random_seed(seed)
     {} catch (const exception &e) {
     cerr << e.what() << " constructing SimpleDP.\n";
     throw runtime_error("SimpleDP constructor failed.");
 }
 
+/**
+ * The cost of building and searching a DPwitness is driven by the number of
+ * light teeth rooted in its partition, which can vary a lot between
+ * partitions on clustered instances. Handing out the largest witnesses
+ * first keeps a few big ones from being left for last.
+ * @pre candidates.get_light_teeth() has been called.
+ * @returns the indices of the partitions of kpart, sorted by decreasing
+ * tooth count, ties broken by index.
+ */
+vector<int> Sep::SimpleDP::part_schedule() const
+{
+    const vector<int> &perm = act_tour.tour_perm();
+    int numparts = kpart.num_parts();
+    vector<int> part_teeth(numparts, 0);
+
+    for (int i = 0; i < numparts; ++i)
+        for (int node : kpart[i])
+            part_teeth[i] += candidates.light_teeth[perm[node]].size();
+
+    vector<int> result(numparts);
+    std::iota(result.begin(), result.end(), 0);
+
+    std::stable_sort(result.begin(), result.end(),
+                     [&part_teeth](int a, int b)
+                     { return part_teeth[a] > part_teeth[b]; });
+
+    return result;
+}
+
 #if !(CMR_USE_OMP)
 /////////////////////// SERIAL IMPLEMENTATION //////////////////////////////////
 bool Sep::SimpleDP::find_cuts()
@@ -114,8 +148,8 @@ bool Sep::SimpleDP::find_cuts()
 {
     runtime_error err("Problem in SimpleDP::find_cuts.");
 
-    bool at_capacity = false;
-    bool caught_exception = false;
+    std::atomic<bool> at_capacity(false);
+    std::atomic<bool> caught_exception(false);
 
     Timer find_total("Parallel simple DP sep");
     Timer find_cands("finding candid teeth", &find_total);
@@ -138,47 +172,63 @@ bool Sep::SimpleDP::find_cuts()
     if (verbose)
         cout << "Parallel search over witness graphs" << endl;
 
+    vector<int> schedule;
+    try { schedule = part_schedule(); }
+    CMR_CATCH_PRINT_THROW("ordering partitions", err);
+
+    int numparts = schedule.size();
+
     Timer search_wit("make/search witness", &find_total);
     search_wit.start();
-    #pragma omp parallel for
-    for (int i = 0; i < kpart.num_parts(); ++i) {
-        if(at_capacity || caught_exception)
+
+    // Partitions are dealt out one at a time, largest first, so a thread
+    // that finishes early takes the next biggest remaining witness. Once
+    // enough cuts are found, pending partitions are skipped and running
+    // searches poll at_capacity to stop early. Each partition gets its own
+    // queue, and the queues are spliced in schedule order afterwards so the
+    // order of dp_q does not depend on which thread finished first.
+    vector<CutQueue<dominoparity>> part_qs(numparts);
+    std::atomic<int> found_count(dp_q.size());
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int k = 0; k < numparts; ++k) {
+        if (at_capacity || caught_exception)
             continue;
-        CutQueue<dominoparity> mini_q;
+
+        int i = schedule[k];
+        CutQueue<dominoparity> &mini_q = part_qs[k];
 
         try {
             DPwitness cutgraph(candidates, kpart[i], random_seed);
 
-            cutgraph.simple_DP_sep(mini_q);
+            cutgraph.simple_DP_sep(mini_q, at_capacity);
         } catch (const exception &e) {
             #pragma omp critical
             {
                 cerr << "Caught " << e.what() << " in witness subproblem.\n";
                 caught_exception = true;
             }
+            continue;
         }
 
-        if(caught_exception)
-            continue;
+        int total = (found_count += mini_q.size());
 
-        #pragma omp critical
-        {
-        if (verbose)
+        if (verbose) {
+            #pragma omp critical
             cout << "\t" << mini_q.size() << " cuts from partition "
                  << i << "\n";
+        }
 
-            dp_q.splice(mini_q);
-
-            if(dp_q.size() >= 250 && !at_capacity) {
-                if (verbose)
-                    cout << "DP q has size " << dp_q.size() << ", "
-                         << "terminating on part number "
-                         << i << endl;
-                at_capacity = true;
-            }
+        if (total >= 250 && !at_capacity.exchange(true) && verbose) {
+            #pragma omp critical
+            cout << "DP q has size " << total << ", "
+                 << "terminating on part number " << i << endl;
         }
     }
 
+    for (CutQueue<dominoparity> &mini_q : part_qs)
+        dp_q.splice(mini_q);
+
     search_wit.stop();
     find_total.stop();
 
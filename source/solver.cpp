@@ -51,6 +51,7 @@ try : tsp_instance(fname, make_seed(seed)),
       output_prefs(outprefs)
 {
     initial_prints();
+    load_cut_pool();
 } catch (const exception &e) {
     cerr << e.what() << endl;
     throw runtime_error("Solver TSPLIB constructor failed.");
@@ -69,6 +70,7 @@ try : tsp_instance(fname, make_seed(seed)),
       output_prefs(outprefs)
 {
     initial_prints();
+    load_cut_pool();
 } catch (const exception &e) {
     cerr << e.what() << endl;
     throw runtime_error("Solver TSPLIB/tour constructor failed.");
@@ -88,6 +90,7 @@ try : tsp_instance(make_seed(seed), node_count, gridsize),
       output_prefs(outprefs)
 {
     initial_prints();
+    load_cut_pool();
 } catch (const exception &e) {
     cerr << e.what() << endl;
     throw runtime_error("Solver random constructor failed.");
@@ -96,6 +99,49 @@ try : tsp_instance(make_seed(seed), node_count, gridsize),
 Solver::Solver(int seed, int node_count, int gridsize, OutPrefs outprefs)
     : Solver(seed, node_count, gridsize, Graph::EdgePlan::Linkern, outprefs) {}
 
+/// The CoreGraph saved in \p ckpt, checking that it was made for \p inst.
+static Graph::CoreGraph checkpoint_graph(const Data::Instance &inst,
+                                         const Data::Checkpoint &ckpt)
+{
+    if (ckpt.probname != inst.problem_name() ||
+        ckpt.ncount != inst.node_count())
+        throw runtime_error("Checkpoint is for instance " + ckpt.probname +
+                            " with " + std::to_string(ckpt.ncount) +
+                            " nodes");
+
+    return Graph::CoreGraph(ckpt.ncount, ckpt.core_edges.size() / 2,
+                            ckpt.core_edges.data(),
+                            [&inst](int i, int j)
+                            { return inst.edgelen(i, j); });
+}
+
+Solver::Solver(const string &tsp_fname, const string &ckpt_fname,
+               OutPrefs outprefs)
+    : Solver(tsp_fname, util::make_unique<Data::Checkpoint>(ckpt_fname),
+             outprefs) {}
+
+/**
+ * The best tour of \p ckpt becomes the reference tour of the new CoreLP.
+ * The saved cuts are mapped onto it and added to the LP in their saved
+ * order, so row indices in the saved bases are unchanged.
+ */
+Solver::Solver(const string &fname, unique_ptr<Data::Checkpoint> ckpt,
+               OutPrefs outprefs)
+try : tsp_instance(fname, ckpt->seed),
+      karp_part(tsp_instance),
+      core_graph(checkpoint_graph(tsp_instance, *ckpt)),
+      best_data(tsp_instance, core_graph, ckpt->best_tour),
+      core_lp(core_graph, best_data),
+      output_prefs(outprefs)
+{
+    initial_prints();
+    restore_checkpoint(*ckpt);
+    resume_point = std::move(ckpt);
+} catch (const exception &e) {
+    cerr << e.what() << endl;
+    throw runtime_error("Solver checkpoint constructor failed.");
+}
+
 void Solver::choose_cuts(CutSel::Presets preset)
 {
     using CutPre = CutSel::Presets;
@@ -217,6 +263,166 @@ void Solver::report_cuts()
          << core_lp.ext_cuts.pool_count() << " cuts in pool)\n" << endl;
 }
 
+/**
+ * A missing pool file is not an error, since it will be created when the
+ * Solver is destroyed. A malformed one is reported and ignored.
+ */
+void Solver::load_cut_pool()
+{
+    const string &fname = output_prefs.pool_file;
+    if (fname.empty())
+        return;
+
+    try {
+        int count = core_lp.ext_cuts.load_pool(fname);
+        if (count > 0)
+            cout << "Loaded " << count << " cuts from pool file " << fname
+                 << ", " << core_lp.ext_cuts.pool_count() << " in pool"
+                 << endl;
+    } catch (const exception &e) {
+        cerr << e.what() << ", ignoring pool file " << fname << endl;
+    }
+}
+
+/**
+ * If edges were added to the core graph to hold the Padberg-Hong basis of
+ * the best tour, the saved bases are extended with them at their lower
+ * bounds, which keeps them valid.
+ */
+static void pad_basis(LP::Basis &base, int old_ecount, int new_ecount)
+{
+    if (base.colstat.size() == old_ecount)
+        base.colstat.resize(new_ecount, LP::BStat::AtLower);
+}
+
+void Solver::restore_checkpoint(const Data::Checkpoint &ckpt)
+{
+    runtime_error err("Problem in Solver::restore_checkpoint");
+
+    if (best_data.min_tour_value != ckpt.best_value) {
+        cerr << "Saved tour has length " << best_data.min_tour_value
+             << ", checkpoint says " << ckpt.best_value << endl;
+        throw err;
+    }
+
+    try {
+        Sep::CutQueue<Sep::HyperGraph> lp_q;
+        core_lp.ext_cuts.load_image(ckpt.cuts, lp_q);
+        core_lp.add_cuts(lp_q);
+    } CMR_CATCH_PRINT_THROW("restoring cuts", err);
+
+    try {
+        if (ckpt.tourless) {
+            core_lp.tourless_mode();
+        } else {
+            LP::Basis base;
+            base.colstat = ckpt.active_base.colstat;
+            base.rowstat = ckpt.active_base.rowstat;
+            pad_basis(base, ckpt.core_edges.size() / 2,
+                      core_graph.edge_count());
+
+            core_lp.active_tour = LP::ActiveTour(ckpt.active_tour, core_lp,
+                                                 core_graph);
+            core_lp.active_tour.set_basis(std::move(base));
+            core_lp.instate_active();
+        }
+    } CMR_CATCH_PRINT_THROW("restoring active tour", err);
+
+    cout << "Restored checkpoint with " << ckpt.cuts.lp_count
+         << " LP cuts, " << ckpt.nodes.size() << " branch nodes, best tour "
+         << best_data.min_tour_value << endl;
+}
+
+/**
+ * Nothing is written unless OutPrefs::checkpoint_file is set and
+ * OutPrefs::checkpoint_interval seconds have passed since the last write.
+ * A failed write is reported but does not stop the search.
+ * @param cur the BranchNode about to be examined by abc_bcp, whose ancestors
+ * are exactly the clamped nodes.
+ */
+void Solver::checkpoint(const ABC::BranchNode &cur)
+{
+    const string &fname = output_prefs.checkpoint_file;
+    if (fname.empty() ||
+        util::real_zeit() - last_checkpoint < output_prefs.checkpoint_interval)
+        return;
+
+    double t = util::real_zeit();
+
+    try {
+        Data::Checkpoint ckpt;
+
+        ckpt.probname = tsp_instance.problem_name();
+        ckpt.seed = tsp_instance.seed();
+        ckpt.ncount = tsp_instance.node_count();
+
+        for (const Graph::Edge &e : core_graph.get_edges()) {
+            ckpt.core_edges.push_back(e.end[0]);
+            ckpt.core_edges.push_back(e.end[1]);
+        }
+
+        ckpt.best_tour = best_data.best_tour_nodes;
+        ckpt.best_value = best_data.min_tour_value;
+
+        ckpt.cuts = core_lp.ext_cuts.get_image();
+
+        const LP::ActiveTour &T = core_lp.active_tour;
+        ckpt.active_tour = T.nodes();
+        ckpt.tourless = T.tourless();
+        ckpt.active_base.colstat = T.base().colstat;
+        ckpt.active_base.rowstat = T.base().rowstat;
+
+        ckpt.set_history(branch_controller->get_history(), cur);
+        ckpt.write(fname);
+
+        cout << "\tWrote checkpoint " << fname << " in "
+             << (util::real_zeit() - t) << "s" << endl;
+    } catch (const exception &e) {
+        cerr << e.what() << ", checkpoint not written" << endl;
+    }
+
+    last_checkpoint = util::real_zeit();
+}
+
+void Solver::resume_abc(bool do_price)
+{
+    runtime_error err("Problem in Solver::resume_abc");
+
+    if (do_price)
+        try {
+            time_price.resume();
+            edge_pricer = util::make_unique<Price::Pricer>(core_lp,
+                                                           tsp_instance,
+                                                           core_graph);
+            time_price.stop();
+            edge_pricer->verbose = output_prefs.verbose;
+        } CMR_CATCH_PRINT_THROW("instantiating/allocating Pricer", err);
+
+    core_lp.verbose = output_prefs.verbose;
+
+    ABC::BranchHistory history;
+    ABC::BranchHistory::iterator cur;
+
+    try {
+        resume_point->get_history(history, cur);
+        for (ABC::BranchNode &B : history)
+            if (!B.price_basis.empty()) {
+                LP::Basis base = B.price_basis.unpack();
+                pad_basis(base, resume_point->core_edges.size() / 2,
+                          core_graph.edge_count());
+                B.price_basis = LP::BasisDelta(base, nullptr);
+            }
+    } CMR_CATCH_PRINT_THROW("rebuilding branch history", err);
+
+    cout << "\tResuming at " << ABC::bnode_brief(*cur) << " of "
+         << history.size() << " branch nodes" << endl;
+
+    try { branch_controller->resume(history, cur); }
+    CMR_CATCH_PRINT_THROW("resuming branch controller", err);
+
+    resume_point.reset();
+}
+
 void Solver::initial_prints()
 {
     time_overall.start();
@@ -414,6 +620,17 @@ PivType Solver::cutting_loop(bool do_price, bool try_recover, bool pure_cut)
 
 Solver::~Solver()
 {
+    if (!output_prefs.pool_file.empty()) {
+        try {
+            core_lp.ext_cuts.save_pool(output_prefs.pool_file);
+            if (output_prefs.verbose)
+                cout << "Saved cut pool to " << output_prefs.pool_file
+                     << endl;
+        } catch (const exception &e) {
+            cerr << e.what() << " saving cut pool" << endl;
+        }
+    }
+
     if (!output_prefs.detailed_stats)
         return;
 
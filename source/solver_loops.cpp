@@ -295,19 +295,18 @@ PivType Solver::cut_and_piv(bool do_price)
             CUT_PIV_CALL(sep, pool_sep(core_lp.ext_cuts), cutpool_q,
                          "CutPool");
 
-        if (cut_sel.segment)
-            CUT_PIV_CALL(sep, segment_sep(), segment_q, "SegmentCuts");
-
         if (cut_sel.connect && !supp_data.connected) {
+            if (cut_sel.segment)
+                CUT_PIV_CALL(sep, segment_sep(), segment_q, "SegmentCuts");
+
             STD_SEC_PIV_LOOP("ConnectCuts", connect_sep, connect_cuts_q);
             continue;
         }
 
-        if (cut_sel.fast2m)
-            CUT_PIV_CALL(sep, fast2m_sep(), fastblossom_q, "FastBlossoms");
-
-        if (cut_sel.blkcomb)
-            CUT_PIV_CALL(sep, blkcomb_sep(), blockcomb_q, "BlockCombs");
+        if (cut_sel.segment || cut_sel.fast2m || cut_sel.blkcomb)
+            CUT_PIV_CALL(sep, concurrent_sep(cut_sel.segment, cut_sel.fast2m,
+                                             cut_sel.blkcomb),
+                         concurrent_q, "SegFastBlock");
 
         if (cut_sel.ex2m)
             CUT_PIV_CALL(sep, exact2m_sep(), exblossom_q, "ExactBlossoms");
@@ -424,10 +423,11 @@ void Solver::opt_check_prunable(bool do_price, ABC::BranchNode &prob)
 
     double opt_time = util::zeit();
     try {
-        if (prob.price_basis && !prob.price_basis->empty()) {
+        if (!prob.price_basis.empty()) {
             cout << "optimal estimate";
-            core_lp.copy_base(prob.price_basis->colstat,
-                              prob.price_basis->rowstat);
+            LP::Basis base = prob.price_basis.unpack();
+            prob.price_basis.clear();
+            core_lp.copy_base(base.colstat, base.rowstat);
         } else {
             cout << "high estimate";
             core_lp.copy_start(core_lp.active_tour.edges());
@@ -490,6 +490,8 @@ PivType Solver::abc_bcp(bool do_price)
     while (cur != branch_controller->get_history().end()) {
         cout << "\n";
 
+        checkpoint(*cur);
+
         if (cur->stat == BranchStat::NeedsRecover) {
             cout << ABC::bnode_brief(*cur) << " needs feas recover"
                  << endl;
@@ -574,9 +576,13 @@ PivType Solver::abc_bcp(bool do_price)
             cur->stat = BranchStat::Done;
         }
 
+        cur->price_basis.clear();
+
         time_branch.resume();
-        try { branch_controller->do_unbranch(*cur); }
-        CMR_CATCH_PRINT_THROW("unbranching pruned problem", err);
+        try {
+            branch_controller->do_unbranch(*cur);
+            branch_controller->reclaim(cur);
+        } CMR_CATCH_PRINT_THROW("unbranching pruned problem", err);
 
         cur = branch_controller->next_prob();
         time_branch.stop();
@@ -644,7 +650,7 @@ void Solver::reset_separator(unique_ptr<Sep::Separator> &S)
 {
     util::ptr_reset(S, core_graph.get_edges(), active_tour(),
                     core_lp.supp_data, karp_part,
-                    tsp_instance.seed());
+                    tsp_instance.seed(), tg_cache);
     S->filter_primal = !active_tour().tourless();
     S->verbose = output_prefs.verbose;
 }
@@ -652,7 +658,7 @@ void Solver::reset_separator(unique_ptr<Sep::Separator> &S)
 void Solver::reset_separator(std::unique_ptr<Sep::MetaCuts> &MS)
 {
     util::ptr_reset(MS, core_lp.external_cuts(), graph_info().get_edges(),
-                    active_tour(), core_lp.supp_data);
+                    active_tour(), core_lp.supp_data, tg_cache);
     MS->filter_primal = !active_tour().tourless();
     MS->verbose = output_prefs.verbose;
 }
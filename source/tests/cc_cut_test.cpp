@@ -75,6 +75,59 @@ SCENARIO("Filtering primal cuts frees and deletes cuts from list",
   */
 }
 
+SCENARIO("Reusing a TourGraph through a TourGraphCache",
+         "[TourGraph][TourGraphCache]") {
+    using namespace CMR;
+    Graph::CoreGraph core_graph;
+    Data::BestGroup b_dat;
+    Data::SupportGroup s_dat;
+    std::vector<double> lp_edges;
+
+    GIVEN("A TourGraphCache for a tour of pr76") {
+        REQUIRE_NOTHROW(Data::make_cut_test("problems/pr76.tsp",
+                                            "test_data/tours/pr76.sol",
+                                            "test_data/subtour_lp/pr76.sub.x",
+                                            core_graph, b_dat, lp_edges,
+                                            s_dat));
+        vector<double> d_tour_edges(b_dat.best_tour_edges.begin(),
+                                    b_dat.best_tour_edges.end());
+        vector<Graph::Edge> edges = core_graph.get_edges();
+        int ecount = edges.size();
+
+        Sep::TourGraphCache tg_cache;
+        Sep::TourGraph &TG = tg_cache.get(d_tour_edges, edges, b_dat.perm);
+        CCtsp_lpedge *first_edges = TG.pass_ptr()->edges;
+
+        THEN("Repeated gets do not rebuild the graph") {
+            REQUIRE(tg_cache.build_count() == 1);
+            REQUIRE(TG.pass_ptr()->ecount == ecount);
+
+            tg_cache.get(d_tour_edges, edges, b_dat.perm);
+            CHECK(tg_cache.build_count() == 1);
+            CHECK(TG.pass_ptr()->edges == first_edges);
+        }
+
+        THEN("Adding an edge extends the graph") {
+            edges.emplace_back(b_dat.best_tour_nodes[0],
+                               b_dat.best_tour_nodes[2], 1);
+            d_tour_edges.push_back(0.0);
+
+            Sep::TourGraph &new_TG = tg_cache.get(d_tour_edges, edges,
+                                                  b_dat.perm);
+            CHECK(tg_cache.build_count() == 2);
+            CHECK(new_TG.pass_ptr()->ecount == ecount + 1);
+
+            Sep::TourGraph fresh_TG(d_tour_edges, edges, b_dat.perm);
+            const CCtsp_lpgraph *cached = new_TG.pass_ptr();
+            const CCtsp_lpgraph *fresh = fresh_TG.pass_ptr();
+            for (int i = 0; i < ecount + 1; ++i) {
+                CHECK(cached->edges[i].ends[0] == fresh->edges[i].ends[0]);
+                CHECK(cached->edges[i].ends[1] == fresh->edges[i].ends[1]);
+            }
+        }
+    }
+}
+
 // TEST_CASE("Basic member tests",
 // 	  "[LPcutList]") {
 //   Sep::LPcutList wrap;
@@ -62,35 +62,38 @@ SCENARIO ("Registering abstract cliques in a bank",
                 nodes2.push_back(i);
 
             WHEN ("We add distinct nodes") {
-                auto ptr1 = cbank.add_clique(nodes1);
-                auto ptr2 = cbank.add_clique(nodes2);
+                Sep::CliqueId id1 = cbank.add_clique(nodes1);
+                Sep::CliqueId id2 = cbank.add_clique(nodes2);
 
                 THEN ("Size and refcounts increase") {
                     REQUIRE(cbank.size() == 2);
-                    REQUIRE(ptr1.use_count() == 2);
-                    REQUIRE(ptr2.use_count() == 2);
+                    REQUIRE(id1 != id2);
+                    REQUIRE(cbank.use_count(id1) == 1);
+                    REQUIRE(cbank.use_count(id2) == 1);
 
                     AND_WHEN ("We add a duplicate") {
-                        auto ptr1_copy = cbank.add_clique(nodes1);
+                        Sep::CliqueId id1_copy = cbank.add_clique(nodes1);
 
                         THEN ("Size is unchanged but ref goes up") {
                             REQUIRE(cbank.size() == 2);
-                            REQUIRE(ptr1_copy.use_count() == 3);
+                            REQUIRE(id1_copy == id1);
+                            REQUIRE(cbank.use_count(id1) == 2);
 
                             AND_WHEN ("We remove a copied clique") {
-                                cbank.del_clique(ptr1_copy);
+                                cbank.del_clique(id1_copy);
 
                                 THEN ("Size is unchanged but ref goes down") {
                                     REQUIRE(cbank.size() == 2);
-                                    REQUIRE(ptr1.use_count() == 2);
+                                    REQUIRE(cbank.use_count(id1) == 1);
 
                                     AND_WHEN ("We remove a lone clique") {
-                                        cbank.del_clique(ptr2);
+                                        cbank.del_clique(id2);
 
-                                        THEN ("Size goes down, clique is null")
+                                        THEN ("Size goes down, id is dead")
                                         {
                                             REQUIRE(cbank.size() == 1);
-                                            REQUIRE_FALSE(ptr2);
+                                            REQUIRE_FALSE(cbank.live(id2));
+                                            REQUIRE(cbank.live(id1));
                                         }
                                     }
                                 }
@@ -103,6 +106,51 @@ SCENARIO ("Registering abstract cliques in a bank",
     }
 }
 
+SCENARIO ("Recycling ids and segments in a CliqueBank",
+          "[Clique][CliqueBank][arena]") {
+    using namespace CMR;
+    GIVEN ("A 2000 node tour and a bank with many single node cliques") {
+        int sz = 2000;
+        vector<int> tour(sz), perm(sz);
+        make_tour_perm(tour, perm);
+
+        Sep::CliqueBank cbank(tour, perm);
+        vector<Sep::CliqueId> ids;
+
+        for (int i = 0; i < sz; ++i)
+            ids.push_back(cbank.add_clique(vector<int>{i}));
+
+        REQUIRE(cbank.size() == sz);
+        REQUIRE(cbank.id_bound() == sz);
+
+        THEN ("Deleting most of them compacts the arena but keeps the rest") {
+            for (int i = 0; i < sz; ++i)
+                if (i % 10 != 0)
+                    cbank.del_clique(ids[i]);
+
+            REQUIRE(cbank.size() == sz / 10);
+
+            for (int i = 0; i < sz; i += 10) {
+                REQUIRE(cbank.live(ids[i]));
+                REQUIRE(cbank.node_list(ids[i]) == vector<int>{i});
+                REQUIRE(cbank.find(Sep::Clique(vector<int>{i}, perm, false))
+                        == ids[i]);
+            }
+
+            AND_THEN ("New cliques reuse the freed ids") {
+                Sep::CliqueId id = cbank.add_clique(vector<int>{1, 2, 3});
+                REQUIRE(id < sz);
+                REQUIRE(cbank.id_bound() == sz);
+                REQUIRE(cbank.contains(id, perm[2]));
+
+                vector<int> nodes = cbank.node_list(id);
+                std::sort(nodes.begin(), nodes.end());
+                REQUIRE(nodes == vector<int>({1, 2, 3}));
+            }
+        }
+    }
+}
+
 SCENARIO ("Testing equality and hash values of cliques",
           "[.Clique][.hash][tiny]") {
     using namespace CMR;
@@ -135,6 +183,49 @@ SCENARIO ("Testing equality and hash values of cliques",
     }
 }
 
+SCENARIO ("Membership and hashing of cliques with many segments",
+          "[Clique][contains][hash]") {
+    using namespace CMR;
+    vector<int> sizes{50, 250, 1000};
+
+    for (int sz : sizes) {
+        GIVEN ("A " + std::to_string(sz) + " node tour and a random subset") {
+            vector<int> tour(sz), perm(sz);
+            make_tour_perm(tour, perm);
+
+            vector<int> nodes;
+            for (int i = 0; i < sz; ++i)
+                if (rand() % 3 == 0)
+                    nodes.push_back(i);
+            if (nodes.empty())
+                nodes.push_back(0);
+
+            Sep::Clique clq(nodes, perm, false);
+
+            THEN ("Binary search membership agrees with the node list") {
+                REQUIRE(clq.is_sorted());
+                REQUIRE(clq.node_count() == nodes.size());
+
+                vector<int> in_clq(sz, 0);
+                for (int n : nodes)
+                    in_clq[n] = 1;
+
+                for (int n = 0; n < sz; ++n)
+                    REQUIRE(clq.contains(perm[n]) == (in_clq[n] == 1));
+
+                AND_THEN ("Shuffled input gives an equal clique and hash") {
+                    vector<int> shuffled = nodes;
+                    std::random_shuffle(shuffled.begin(), shuffled.end());
+                    Sep::Clique clq2(shuffled, perm, false);
+
+                    REQUIRE(clq2 == clq);
+                    REQUIRE(clq2.hash() == clq.hash());
+                }
+            }
+        }
+    }
+}
+
 SCENARIO ("Generating cliques from Concorde cliques",
           "[Clique][Sep]") {
     using namespace CMR;
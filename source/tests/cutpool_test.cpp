@@ -13,6 +13,8 @@
 
 #include <catch.hpp>
 
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -100,6 +102,80 @@ SCENARIO ("Adding duplicate cuts to the pool",
     }
 }
 
+SCENARIO ("Saving and loading a binary cut pool file",
+          "[Sep][ExternalCuts][save_pool][load_pool]") {
+    using namespace CMR;
+    vector<string> probs{"pr76", "d493"};
+
+    for (string &prob : probs) {
+    GIVEN ("Fast blossoms in the LP of " + prob) {
+        string
+        probfile = "problems/" + prob + ".tsp",
+        solfile = "test_data/tours/" + prob + ".sol",
+        subtourfile = "test_data/subtour_lp/" + prob + ".sub.x",
+        poolfile = "test_data/" + prob + ".pool";
+
+        Graph::CoreGraph core_graph;
+        Data::BestGroup b_dat;
+        Data::SupportGroup s_dat;
+        std::vector<double> lp_edges;
+        Sep::LPcutList cutq;
+        Data::make_cut_test(probfile, solfile, subtourfile, core_graph, b_dat,
+                            lp_edges, s_dat);
+
+        vector<double> d_tour_edges(b_dat.best_tour_edges.begin(),
+                                    b_dat.best_tour_edges.end());
+        Sep::TourGraph TG(d_tour_edges, core_graph.get_edges(), b_dat.perm);
+        for (int &i : s_dat.support_elist) i = b_dat.perm[i];
+
+        Sep::FastBlossoms fb_sep(s_dat.support_elist,
+                                 s_dat.support_ecap, TG, cutq);
+        if (!fb_sep.find_cuts())
+            continue;
+
+        const vector<int> &tour = b_dat.best_tour_nodes;
+        Sep::ExternalCuts EC(tour, b_dat.perm);
+        for (CCtsp_lpcut_in *c = cutq.begin(); c; c = c->next)
+            EC.add_cut(*c, tour);
+
+        REQUIRE_NOTHROW(EC.save_pool(poolfile));
+        auto fguard = util::make_guard([&poolfile]
+                                       { std::remove(poolfile.c_str()); });
+
+    WHEN ("The pool is loaded with the same reference tour") {
+        Sep::ExternalCuts loaded(tour, b_dat.perm);
+    THEN ("Every cut is added to the Concorde pool") {
+        REQUIRE(loaded.load_pool(poolfile) == cutq.size());
+        REQUIRE(loaded.pool_count() == cutq.size());
+    }
+    }
+
+    WHEN ("The pool is loaded with a rotated reference tour") {
+        vector<int> rot_tour(tour);
+        std::rotate(rot_tour.begin(), rot_tour.begin() + rot_tour.size() / 3,
+                    rot_tour.end());
+        vector<int> rot_perm(rot_tour.size());
+        for (int i = 0; i < rot_tour.size(); ++i)
+            rot_perm[rot_tour[i]] = i;
+
+        Sep::ExternalCuts loaded(rot_tour, rot_perm);
+    THEN ("Every cut is added to the Concorde pool") {
+        REQUIRE(loaded.load_pool(poolfile) == cutq.size());
+        REQUIRE(loaded.pool_count() == cutq.size());
+    }
+    }
+
+    WHEN ("A missing pool file is loaded") {
+        Sep::ExternalCuts loaded(tour, b_dat.perm);
+    THEN ("No cuts are added") {
+        REQUIRE(loaded.load_pool(poolfile + ".missing") == 0);
+        REQUIRE(loaded.pool_count() == 0);
+    }
+    }
+    }
+    }
+}
+
 SCENARIO ("Experimenting with CutMonitor metrics",
           "[Sep][LP][pivot_age][CutMonitor][experiment]") {
     using namespace CMR;
@@ -140,4 +140,30 @@ SCENARIO ("Verifying a BestGroup with a GraphGroup",
     }
 }
 
+SCENARIO ("Computing batches of edge lengths",
+          "[Data][Instance][edgelens]") {
+    vector<string> probs{"dantzig42", "pr76", "att532", "lin318"};
+
+    for (string &prob : probs) {
+        GIVEN ("The TSP instance " + prob) {
+            CMR::Data::Instance inst("problems/" + prob + ".tsp", 99);
+            int ncount = inst.node_count();
+
+            THEN ("Batch lengths of the complete graph match edgelen") {
+                vector<CMR::EndPts> edges;
+                for (int i = 0; i < ncount; ++i)
+                    for (int j = i + 1; j < ncount; ++j)
+                        edges.emplace_back(i, j);
+
+                vector<double> lens(edges.size());
+                inst.edgelens(edges.data(), edges.size(), lens.data());
+
+                for (int k = 0; k < edges.size(); ++k)
+                    REQUIRE(lens[k] == inst.edgelen(edges[k].end[0],
+                                                    edges[k].end[1]));
+            }
+        }
+    }
+}
+
 #endif
@@ -11,6 +11,7 @@
 
 #include <catch.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -119,6 +120,51 @@ SCENARIO ("Primal exact blossom separation",
                         }
                     }
                 }
+
+                THEN ("Blossom cut values match per-edge minimum cuts") {
+                    Sep::CutQueue<Sep::ex_blossom> blossom_q;
+                    LP::ActiveTour act_tour(core_graph, b_dat);
+                    Sep::ExBlossoms ex_b(core_graph.get_edges(),
+                                         act_tour, s_dat,
+                                         blossom_q);
+                    ex_b.find_cuts();
+
+                    vector<int> &sup_inds = s_dat.support_indices;
+                    vector<double> &sup_ecap = s_dat.support_ecap;
+                    vector<int> &sup_elist = s_dat.support_elist;
+                    const vector<double> &tour_edges = act_tour.edges();
+                    int ncount = core_graph.node_count();
+
+                    vector<double> cut_ecap = sup_ecap;
+                    for (int i = 0; i < sup_inds.size(); ++i)
+                        if (tour_edges[sup_inds[i]] == 1.0)
+                            cut_ecap[i] = 1 - sup_ecap[i];
+
+                    while (!blossom_q.empty()) {
+                        const Sep::ex_blossom &B = blossom_q.peek_front();
+                        int i = std::find(sup_inds.begin(), sup_inds.end(),
+                                          B.cut_edge) - sup_inds.begin();
+                        REQUIRE(i < sup_inds.size());
+
+                        vector<double> flip_ecap = cut_ecap;
+                        flip_ecap[i] = 1 - cut_ecap[i];
+                        double st_val = 1.0;
+                        int *cut_nodes = nullptr;
+                        int cut_count = 0;
+
+                        REQUIRE_FALSE(CCcut_mincut_st(ncount, sup_inds.size(),
+                                                      &sup_elist[0],
+                                                      &flip_ecap[0],
+                                                      sup_elist[2 * i],
+                                                      sup_elist[2 * i + 1],
+                                                      &st_val, &cut_nodes,
+                                                      &cut_count));
+                        CC_IFFREE(cut_nodes, int);
+
+                        CHECK(B.cut_val == Approx(st_val));
+                        blossom_q.pop_front();
+                    }
+                }
             }
         }
     }
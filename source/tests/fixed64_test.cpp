@@ -0,0 +1,83 @@
+#include "config.hpp"
+
+#ifdef CMR_DO_TESTS
+
+#include "fixed64.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <catch.hpp>
+
+using std::vector;
+
+using f64 = CMR::util::Fixed64;
+
+SCENARIO ("Fixed64 matches CCbigguy rounding and range",
+          "[util][Fixed64]") {
+    GIVEN ("Values converted from doubles") {
+        THEN ("Magnitudes are truncated toward zero in units of 2^-32") {
+            REQUIRE(f64(0.1).raw_val() == 429496729);
+            REQUIRE(f64(-0.1).raw_val() == -429496729);
+            REQUIRE(f64(1.5).raw_val() == (std::int64_t{3} << 31));
+            REQUIRE(f64(-7).raw_val() == -7 * f64::One);
+        }
+
+        THEN ("Ceilings round up to the next integer") {
+            REQUIRE(f64(1.5).ceil() == f64(2));
+            REQUIRE(f64(-1.5).ceil() == f64(-1));
+            REQUIRE(f64(-3).ceil() == f64(-3));
+            REQUIRE(f64(0.0).ceil() == f64(0));
+        }
+
+        THEN ("Leaving the bigguy range throws") {
+            REQUIRE_THROWS_AS(f64(3.0e9), std::overflow_error);
+            REQUIRE_THROWS_AS(f64(std::numeric_limits<double>::quiet_NaN()),
+                              std::overflow_error);
+
+            f64 big(2147483000.0);
+            REQUIRE_THROWS_AS(big += f64(1000), std::overflow_error);
+            REQUIRE_THROWS_AS(CMR::util::add_mult(big, big, 2),
+                              std::overflow_error);
+        }
+    }
+
+    GIVEN ("An array of mixed sign values") {
+        vector<f64> vals;
+        for (int i = 0; i < 1000; ++i)
+            vals.emplace_back((i % 7 - 3) * 1234.567 + i * 0.001);
+
+        THEN ("The batch sum matches repeated increments") {
+            f64 total(0);
+            for (const f64 &v : vals)
+                total += v;
+
+            REQUIRE(CMR::util::sum(vals.data(), vals.size()) == total);
+        }
+
+        THEN ("The batch add_mult matches elementwise add_mult") {
+            vector<f64> batch(vals);
+            CMR::util::add_mult(batch.data(), vals.data(), -3, vals.size());
+
+            for (int i = 0; i < vals.size(); ++i) {
+                f64 x = vals[i];
+                CMR::util::add_mult(x, vals[i], -3);
+                REQUIRE(x == batch[i]);
+            }
+        }
+
+        THEN ("The batch add_mult reports overflow after the loop") {
+            vector<f64> batch(vals);
+            batch.push_back(f64(2147483000.0));
+            vector<f64> src(batch);
+
+            REQUIRE_THROWS_AS(CMR::util::add_mult(batch.data(), src.data(),
+                                                  2, batch.size()),
+                              std::overflow_error);
+        }
+    }
+}
+
+#endif //CMR_DO_TESTS
@@ -115,6 +115,57 @@ SCENARIO ("Constructing support adjacency lists",
                         }
                     }
                 }
+
+                AND_THEN ("Updating matches building from scratch") {
+                    vector<double> tour_x(b_dat.best_tour_edges.begin(),
+                                          b_dat.best_tour_edges.end());
+
+                    for (const vector<double> *x : {&tour_x, &lp_edges}) {
+                        vector<double> old_x = s_dat.lp_vec;
+                        vector<int> up_island;
+                        vector<int> fresh_island;
+
+                        s_dat.update(edges, *x, up_island, ncount);
+                        Data::SupportGroup fresh(edges, *x, fresh_island,
+                                                 ncount);
+
+                        CHECK(s_dat.lp_vec == fresh.lp_vec);
+                        CHECK(s_dat.support_indices == fresh.support_indices);
+                        CHECK(s_dat.support_ecap == fresh.support_ecap);
+                        CHECK(s_dat.support_elist == fresh.support_elist);
+                        CHECK(s_dat.connected == fresh.connected);
+                        CHECK(s_dat.integral == fresh.integral);
+                        CHECK(s_dat.supp_graph.edge_count ==
+                              fresh.supp_graph.edge_count);
+                        if (s_dat.integral && s_dat.connected) {
+                            REQUIRE(up_island.size() == ncount);
+                            for (int k = 0; k < ncount; ++k) {
+                                int n0 = up_island[k];
+                                int n1 = up_island[(k + 1) % ncount];
+                                CHECK(sup_alist.find_edge(n0, n1) != nullptr);
+                            }
+                        }
+
+                        vector<int> diff;
+                        for (int i = 0; i < x->size(); ++i)
+                            if ((*x)[i] != old_x[i])
+                                diff.push_back(i);
+                        CHECK(s_dat.changed_edges == diff);
+
+                        for (int i = 0; i < edges.size(); ++i) {
+                            const Graph::Edge &e = edges[i];
+                            auto found_ptr = sup_alist.find_edge(e.end[0],
+                                                                 e.end[1]);
+                            if ((*x)[i] < Epsilon::Zero) {
+                                CHECK(found_ptr == nullptr);
+                            } else {
+                                REQUIRE(found_ptr != nullptr);
+                                CHECK(found_ptr->edge_index == i);
+                                CHECK(found_ptr->val == (*x)[i]);
+                            }
+                        }
+                    }
+                }
             }
         }
     }
@@ -176,6 +176,36 @@ SCENARIO ("Comparing priceless HyperGraph coeffs to CPLEX coefs",
                  CHECK(ex_cmatval == cpx_cmatval);
              }
 
+             AND_THEN ("Batch columns agree with single columns") {
+                 vector<int> cmatbeg;
+                 vector<int> cmatind;
+                 vector<double> cmatval;
+
+                 REQUIRE_NOTHROW(core_lp.external_cuts()
+                                 .get_cols(edges, cmatbeg, cmatind, cmatval));
+                 REQUIRE(cmatbeg.size() == edges.size());
+
+                 for (int i = 0; i < edges.size(); ++i) {
+                     vector<int> ex_cmatind;
+                     vector<double> ex_cmatval;
+
+                     core_lp.external_cuts().get_col(edges[i].end[0],
+                                                     edges[i].end[1],
+                                                     ex_cmatind, ex_cmatval);
+
+                     int beg = cmatbeg[i];
+                     int end = (i + 1 < edges.size()) ? cmatbeg[i + 1]
+                     : cmatind.size();
+
+                     INFO ("Column " << i);
+                     CHECK(vector<int>(cmatind.begin() + beg,
+                                       cmatind.begin() + end) == ex_cmatind);
+                     CHECK(vector<double>(cmatval.begin() + beg,
+                                          cmatval.begin() + end) ==
+                           ex_cmatval);
+                 }
+             }
+
          AND_WHEN("We get row coeffs") {
          THEN ("They also agree with CPLEX") {
              for (int i = core_graph.node_count(); i < numrows; ++i) {
@@ -201,6 +231,33 @@ SCENARIO ("Comparing priceless HyperGraph coeffs to CPLEX coefs",
                  CHECK(rel_row.rmatind == hg_row.rmatind);
                  CHECK(rel_row.rmatval == hg_row.rmatval);
              }
+
+             AND_THEN ("Batch rows agree with rows from single cuts") {
+                 const vector<Sep::HyperGraph> &cuts =
+                 core_lp.external_cuts().get_cuts();
+                 vector<const Sep::HyperGraph *> cut_ptrs;
+                 vector<LP::SparseRow> batch_rows;
+                 vector<int> end_pos;
+
+                 for (const Sep::HyperGraph &H : cuts)
+                     cut_ptrs.push_back(&H);
+
+                 REQUIRE_NOTHROW(Sep::HyperGraph::get_coeffs(edges, cut_ptrs,
+                                                             batch_rows,
+                                                             end_pos));
+                 REQUIRE(batch_rows.size() == cuts.size());
+
+                 for (int i = 0; i < cuts.size(); ++i) {
+                     LP::SparseRow hg_row;
+                     cuts[i].get_coeffs(edges, hg_row.rmatind,
+                                        hg_row.rmatval);
+
+                     CHECK(batch_rows[i].rhs == cuts[i].get_rhs());
+                     CHECK(batch_rows[i].sense == cuts[i].get_sense());
+                     CHECK(batch_rows[i].rmatind == hg_row.rmatind);
+                     CHECK(batch_rows[i].rmatval == hg_row.rmatval);
+                 }
+             }
          }
          }
          }
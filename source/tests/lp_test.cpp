@@ -15,6 +15,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -241,6 +242,74 @@ SCENARIO ("Benchmarking rounds of cuts",
     }
 }
 
+SCENARIO ("Running separators concurrently",
+          "[LP][CoreLP][primal_pivot][Sep][Separator][concurrent_sep]") {
+    using namespace CMR;
+    vector<string> probs{"pr76", "a280", "p654", "pr1002"};
+
+    for (string &prob : probs) {
+        GIVEN ("A first primal pivot on " + prob) {
+            Data::Instance inst("problems/" + prob + ".tsp", 99);
+            Graph::CoreGraph core_graph(inst);
+            Data::BestGroup b_dat(inst, core_graph);
+            LP::CoreLP core(core_graph, b_dat);
+
+            REQUIRE_NOTHROW(core.primal_pivot());
+            vector<double> pivx = core.lp_vec();
+            int ncount = inst.node_count();
+
+            vector<int> island;
+            Data::SupportGroup s_dat(core_graph.get_edges(), pivx, island,
+                                     ncount);
+            Data::KarpPartition kpart;
+
+            THEN ("Concurrent separation finds the cuts of separate calls") {
+                using Sep::Separator;
+                const vector<Graph::Edge> &edges = core_graph.get_edges();
+                const LP::ActiveTour &act_tour = core.get_active_tour();
+
+                Separator seg_sep(edges, act_tour, s_dat, kpart, 99);
+                Separator f2m_sep(edges, act_tour, s_dat, kpart, 99);
+                Separator blk_sep(edges, act_tour, s_dat, kpart, 99);
+                Separator conc_sep(edges, act_tour, s_dat, kpart, 99);
+
+                bool seg = seg_sep.segment_sep();
+                bool f2m = f2m_sep.fast2m_sep();
+                bool blk = blk_sep.blkcomb_sep();
+                bool conc = false;
+
+                REQUIRE_NOTHROW(conc = conc_sep.concurrent_sep(true, true,
+                                                               true));
+                CHECK(conc == (seg || f2m || blk));
+                CHECK(conc_sep.concurrent_q().size() ==
+                      (seg_sep.segment_q().size() +
+                       f2m_sep.fastblossom_q().size() +
+                       blk_sep.blockcomb_q().size()));
+
+                AND_THEN ("Disabled routines contribute no cuts") {
+                    Separator seg_only(edges, act_tour, s_dat, kpart, 99);
+                    REQUIRE_NOTHROW(seg_only.concurrent_sep(true, false,
+                                                            false));
+                    CHECK(seg_only.concurrent_q().size() ==
+                          seg_sep.segment_q().size());
+                }
+
+                AND_THEN ("The cuts are added as one block of rows") {
+                    int qsize = conc_sep.concurrent_q().size();
+                    int numrows = core.num_rows();
+                    int ext_count = core.external_cuts().cut_count();
+
+                    REQUIRE_NOTHROW(core.add_cuts(conc_sep.concurrent_q()));
+                    CHECK(core.num_rows() == numrows + qsize);
+                    CHECK(core.external_cuts().cut_count() ==
+                          ext_count + qsize);
+                    CHECK(conc_sep.concurrent_q().empty());
+                }
+            }
+        }
+    }
+}
+
 SCENARIO ("Performing single pivots",
           "[LP][CoreLP][primal_pivot][Sep][Separator]") {
     using namespace CMR;
@@ -361,6 +430,68 @@ SCENARIO ("Consructing a Core LP",
     }
 }
 
+SCENARIO ("Optimizing a Core LP under thread policies",
+          "[LP][CoreLP][ThreadPolicy]") {
+    using namespace CMR;
+    using Mode = LP::ThreadPolicy::Mode;
+    vector<string> probs{"dantzig42", "lin318", "pr1002"};
+
+    for (string &prob : probs) {
+        GIVEN ("The degree LP for " + prob) {
+            Data::Instance inst("problems/" + prob + ".tsp", 99);
+            Graph::CoreGraph core_graph(inst);
+            Data::BestGroup b_dat(inst, core_graph);
+            LP::CoreLP core(core_graph, b_dat);
+
+            vector<double> tour(b_dat.best_tour_edges.begin(),
+                                b_dat.best_tour_edges.end());
+
+            core.primal_opt();
+            double objval = core.get_objval();
+
+            THEN ("One thread optimizes with primal simplex") {
+                core.copy_start(tour);
+                REQUIRE_NOTHROW(core.full_opt());
+                REQUIRE(core.opt_method() == CPX_ALG_PRIMAL);
+                REQUIRE(core.get_objval() == Approx(objval));
+            }
+
+            THEN ("More threads use barrier unless concurrent") {
+                for (Mode mode : {Mode::Deterministic, Mode::Opportunistic}) {
+                    LP::ThreadPolicy policy;
+                    policy.threads = 2;
+                    policy.mode = mode;
+                    REQUIRE_NOTHROW(core.set_thread_policy(policy));
+
+                    core.copy_start(tour);
+                    REQUIRE_NOTHROW(core.full_opt());
+                    REQUIRE(core.opt_method() == CPX_ALG_BARRIER);
+                }
+            }
+
+            THEN ("Each policy finds the same optimal objval") {
+                for (Mode mode : {Mode::Deterministic, Mode::Opportunistic,
+                                  Mode::Concurrent}) {
+                    LP::ThreadPolicy policy;
+                    policy.threads = 0;
+                    policy.mode = mode;
+                    REQUIRE_NOTHROW(core.set_thread_policy(policy));
+
+                    core.copy_start(tour);
+                    REQUIRE_NOTHROW(core.full_opt());
+                    REQUIRE(core.get_objval() == Approx(objval));
+                }
+            }
+
+            THEN ("A negative thread count is rejected") {
+                LP::ThreadPolicy policy;
+                policy.threads = -1;
+                REQUIRE_THROWS(core.set_thread_policy(policy));
+            }
+        }
+    }
+}
+
 SCENARIO ("Constructing LP Relaxations",
           "[.LP][.Relaxation][valgrind]") {
     using namespace CMR;
@@ -403,4 +534,57 @@ SCENARIO ("Black box testing of failures in constructing LP Relaxations",
     }
 }
 
+SCENARIO ("Packing bases as deltas from a reference basis",
+          "[LP][Basis][BasisDelta]") {
+    using namespace CMR;
+
+    GIVEN ("A basis and one differing in a few statuses") {
+        LP::Basis base;
+        for (int i = 0; i < 1001; ++i)
+            base.colstat.push_back(i % 4);
+        for (int i = 0; i < 37; ++i)
+            base.rowstat.push_back(i % 2);
+
+        LP::Basis moved;
+        moved.colstat = base.colstat;
+        moved.rowstat = base.rowstat;
+        moved.colstat[0] = LP::BStat::AtUpper;
+        moved.colstat[1000] = LP::BStat::Basic;
+        moved.rowstat[36] = LP::BStat::AtLower;
+
+        auto ref = std::make_shared<const LP::PackedBasis>(base);
+
+        THEN ("Both unpack to the original statuses") {
+            REQUIRE(ref->unpack().colstat == base.colstat);
+            REQUIRE(ref->unpack().rowstat == base.rowstat);
+
+            LP::BasisDelta delta(moved, ref);
+            LP::Basis unpacked = delta.unpack();
+            REQUIRE(unpacked.colstat == moved.colstat);
+            REQUIRE(unpacked.rowstat == moved.rowstat);
+
+            AND_THEN ("A reference of different size is ignored") {
+                moved.colstat.pop_back();
+                LP::BasisDelta own(moved, ref);
+                unpacked = own.unpack();
+                REQUIRE(unpacked.colstat == moved.colstat);
+                REQUIRE(unpacked.rowstat == moved.rowstat);
+            }
+
+            AND_THEN ("Empty and cleared deltas unpack empty") {
+                REQUIRE(LP::BasisDelta(LP::Basis(), ref).empty());
+                delta.clear();
+                REQUIRE(delta.empty());
+                REQUIRE(delta.unpack().empty());
+            }
+        }
+
+        THEN ("Bad statuses are rejected") {
+            moved.colstat[3] = 4;
+            REQUIRE_THROWS(LP::PackedBasis{moved});
+            REQUIRE_THROWS(LP::BasisDelta(moved, ref));
+        }
+    }
+}
+
 #endif
@@ -540,6 +540,129 @@ SCENARIO ("Optimizing and computing lower bounds",
     }
 }
 
+SCENARIO ("Streaming full graph exact lower bounds in blocks",
+          "[Pricer][Price][exact_lb][full_rc_sum]") {
+    using namespace CMR;
+    using f64 = util::Fixed64;
+    vector<string> probs {
+        "dantzig42",
+        "pr76",
+        "lin318",
+        };
+
+    for (string &prob : probs) {
+        GIVEN ("A priceless cutting_loop run on " + prob) {
+            int seed = 99;
+            string probfile = "problems/" + prob + ".tsp";
+            OutPrefs outprefs;
+            Solver solver(probfile, seed, outprefs);
+
+            solver.cutting_loop(false, false, true);
+
+            LP::CoreLP &core = const_cast<LP::CoreLP &>(solver.
+                                                        get_core_lp());
+            Graph::CoreGraph &core_graph =
+            const_cast<Graph::CoreGraph &>(solver.graph_info());
+
+            core.primal_opt();
+
+            Price::Pricer pricer(core, solver.inst_info(), core_graph);
+            int ncount = core_graph.node_count();
+
+            THEN ("Small blocks give the same bound as one big block") {
+                vector<Price::PrEdge<f64>> big_negs;
+                vector<Price::PrEdge<f64>> small_negs;
+
+                pricer.full_lb_batch = ncount * ncount;
+                f64 big_lb = pricer.exact_lb(true, big_negs);
+
+                pricer.full_lb_batch = 97;
+                f64 small_lb = pricer.exact_lb(true, small_negs);
+
+                REQUIRE(big_lb == small_lb);
+                REQUIRE(big_negs.size() == small_negs.size());
+
+                for (const Price::PrEdge<f64> &e : small_negs) {
+                    REQUIRE(e.end[0] < e.end[1]);
+                    REQUIRE(e.redcost < 0.0);
+                }
+
+                AND_THEN ("The full bound is no better than the core bound") {
+                    f64 core_lb = pricer.exact_lb(false);
+                    REQUIRE(small_lb <= core_lb);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO ("Pricing core edges with the clique edge index",
+          "[Pricer][Price][exact_lb][clique_edges]") {
+    using namespace CMR;
+    using f64 = util::Fixed64;
+    vector<string> probs {
+        "dantzig42",
+        "pr76",
+        "lin318",
+        "d493",
+        };
+
+    for (string &prob : probs) {
+        GIVEN ("A priceless cutting_loop run on " + prob) {
+            int seed = 99;
+            string probfile = "problems/" + prob + ".tsp";
+            OutPrefs outprefs;
+            Solver solver(probfile, seed, outprefs);
+
+            solver.cutting_loop(false, false, true);
+
+            LP::CoreLP &core = const_cast<LP::CoreLP &>(solver.
+                                                        get_core_lp());
+            Graph::CoreGraph &core_graph =
+            const_cast<Graph::CoreGraph &>(solver.graph_info());
+
+            core.primal_opt();
+
+            Price::Pricer pricer(core, solver.inst_info(), core_graph);
+            const Sep::ExternalCuts &ext_cuts = core.external_cuts();
+
+            THEN ("The index tracks the core and agrees with price_edges") {
+                REQUIRE(ext_cuts.indexed_edge_count() ==
+                        core_graph.edge_count());
+
+                vector<Price::PrEdge<f64>> indexed_edges;
+                pricer.exact_lb(false, indexed_edges);
+
+                vector<Price::PrEdge<f64>> swept_edges;
+                for (const Graph::Edge &e : core_graph.get_edges())
+                    swept_edges.emplace_back(e.end[0], e.end[1]);
+
+                std::unique_ptr<LP::DualGroup<f64>> duals =
+                util::make_unique<LP::DualGroup<f64>>(true, core, ext_cuts);
+                pricer.price_edges(swept_edges, duals, true);
+
+                REQUIRE(indexed_edges.size() == swept_edges.size());
+                for (int i = 0; i < swept_edges.size(); ++i)
+                    REQUIRE(indexed_edges[i].redcost ==
+                            swept_edges[i].redcost);
+            }
+
+            THEN ("Updated duals after a pivot match rebuilt duals") {
+                LP::DualGroup<f64> updated(true, core, ext_cuts);
+
+                REQUIRE_NOTHROW(core.primal_pivot());
+                REQUIRE_NOTHROW(updated.update(true, core, ext_cuts));
+
+                LP::DualGroup<f64> rebuilt(true, core, ext_cuts);
+
+                REQUIRE(updated.cut_pi == rebuilt.cut_pi);
+                REQUIRE(updated.node_pi == rebuilt.node_pi);
+                REQUIRE(updated.node_pi_est == rebuilt.node_pi_est);
+            }
+        }
+    }
+}
+
 SCENARIO ("Comparing Pricer reduced costs to CPLEX",
           "[Price][Pricer][price_edges]") {
     using namespace CMR;
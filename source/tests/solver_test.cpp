@@ -3,18 +3,22 @@
 #ifdef CMR_DO_TESTS
 
 #include "solver.hpp"
+#include "batch.hpp"
 #include "util.hpp"
 #include "timer.hpp"
+#include "err_util.hpp"
 
 
 #include <algorithm>
 #include <array>
+#include <fstream>
 #include <vector>
 #include <string>
 #include <iostream>
 #include <iomanip>
 #include <utility>
 
+#include <cstdio>
 #include <cstdlib>
 
 #include <catch.hpp>
@@ -69,4 +73,65 @@ SCENARIO ("Running random 1k solver cutting_loop",
     }
 }
 
+SCENARIO ("Solving a batch of instances",
+          "[Solver][abc][solve_batch]") {
+    vector<string> probs{"dantzig42", "pr76", "lin318", "d493"};
+    vector<double> opt_vals{699, 108159, 42029, 35002};
+
+    GIVEN ("A batch of small TSPLIB instances") {
+        vector<CMR::BatchJob> jobs;
+        for (string &prob : probs) {
+            CMR::OutPrefs prefs;
+            prefs.save_tour = false;
+            jobs.emplace_back("problems/" + prob + ".tsp", 99, prefs);
+        }
+
+        THEN ("Each job is solved to optimality") {
+            vector<CMR::BatchResult> results;
+            REQUIRE_NOTHROW(results = CMR::solve_batch(jobs, 2));
+            REQUIRE(results.size() == jobs.size());
+
+            for (int i = 0; i < jobs.size(); ++i) {
+                INFO(jobs[i].tsp_fname);
+                CHECK(results[i].solved);
+                CHECK(results[i].piv == CMR::LP::PivType::FathomedTour);
+                CHECK(results[i].tour_val == opt_vals[i]);
+            }
+        }
+    }
+}
+
+SCENARIO ("Resuming an ABC search from a checkpoint",
+          "[Solver][abc][Checkpoint]") {
+    vector<string> probs{"dantzig42", "pr76", "lin318"};
+
+    for (string &prob : probs) {
+        GIVEN ("An ABC search on " + prob + " checkpointed at every node") {
+            string probfile = "problems/" + prob + ".tsp";
+            string ckptfile = "test_data/" + prob + ".ckpt";
+            auto fguard = CMR::util::make_guard([&ckptfile]
+                                                { std::remove(ckptfile.c_str());
+                                                });
+            CMR::OutPrefs prefs;
+            prefs.save_tour = false;
+            prefs.checkpoint_file = ckptfile;
+            prefs.checkpoint_interval = 0.0;
+
+            CMR::Solver solver(probfile, 99, prefs);
+            REQUIRE_NOTHROW(solver.abc<CMR::ABC::InterBrancher>(true));
+            double opt = solver.best_info().min_tour_value;
+
+            if (!std::ifstream(ckptfile).good())
+                continue;
+
+            THEN ("A Solver resumed from the last checkpoint finds opt") {
+                CMR::Solver resumed(probfile, ckptfile, prefs);
+                REQUIRE(resumed.best_info().min_tour_value >= opt);
+                REQUIRE_NOTHROW(resumed.abc<CMR::ABC::InterBrancher>(true));
+                REQUIRE(resumed.best_info().min_tour_value == opt);
+            }
+        }
+    }
+}
+
 #endif //CMR_DO_TESTS
@@ -9,6 +9,7 @@
 #include "process_cuts.hpp"
 #include "witness.hpp"
 
+#include <atomic>
 #include <iostream>
 #include <iomanip>
 #include <string>
@@ -124,6 +125,30 @@ SCENARIO("Finding simple DP inequalities via karp partition witnesses",
                 REQUIRE(total_count > 0);
                 cout << "\t" << total_count << " total cuts in "
                      << total_time << "s\n\n";
+
+                AND_THEN("A cancellable search matches unless cancelled") {
+                    std::atomic<bool> cancel(false);
+                    for (int i = 0; i < kpart.num_parts(); ++i) {
+                        Sep::DPwitness plain_graph(cands, kpart[i], 99);
+                        Sep::DPwitness cancel_graph(cands, kpart[i], 99);
+                        Sep::CutQueue<Sep::dominoparity> plain_q(25);
+                        Sep::CutQueue<Sep::dominoparity> cancel_q(25);
+
+                        bool plain = plain_graph.simple_DP_sep(plain_q);
+                        bool found = false;
+                        REQUIRE_NOTHROW(found =
+                                        cancel_graph.simple_DP_sep(cancel_q,
+                                                                   cancel));
+                        CHECK(found == plain);
+                        CHECK(cancel_q.size() == plain_q.size());
+                    }
+
+                    cancel = true;
+                    Sep::DPwitness cancel_graph(cands, kpart[0], 99);
+                    Sep::CutQueue<Sep::dominoparity> cancel_q(25);
+                    CHECK_FALSE(cancel_graph.simple_DP_sep(cancel_q, cancel));
+                    CHECK(cancel_q.empty());
+                }
             }
         }
     }
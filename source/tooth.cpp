@@ -44,11 +44,10 @@ static void tlist_sort(ToothList &T)
     std::sort(T.begin(), T.end(), ptr_cmp);
 }
 
-vector<IteratorMat> CandidateTeeth::seen_ranges;
-
 CandidateTeeth::CandidateTeeth(const LP::ActiveTour &active_tour_,
 			       Data::SupportGroup &_supp_dat) try :
     light_teeth(std::vector<ToothList>(_supp_dat.supp_graph.node_count)),
+    seen_ranges(_supp_dat.supp_graph.node_count),
     list_sizes(_supp_dat.supp_graph.node_count, {{0, 0, 0}}),
     endmark(_supp_dat.supp_graph.node_count, CC_LINSUB_BOTH_END),
     active_tour(active_tour_),
@@ -66,8 +65,6 @@ CandidateTeeth::CandidateTeeth(const LP::ActiveTour &active_tour_,
     t_all.start();
     t_pre.start();
 
-    seen_ranges.resize(ncount);
-
     for (int root_ind = 0; root_ind < ncount; ++root_ind) {
         int actual_vx = tour[root_ind];
         Graph::Node &x = G_s.nodelist[actual_vx];
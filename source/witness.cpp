@@ -51,7 +51,35 @@ bool DPwitness::simple_DP_sep(CutQueue<dominoparity> &dp_q)
         build_gh_tree();
         if (CC_gh_q.empty()) return false;
 
-        grab_dominos(dp_q);
+        grab_dominos(dp_q, nullptr);
+    } catch (const exception &e) {
+        cerr << e.what() << "\n";
+        throw runtime_error("Problem in DPwitness::simple_DP_sep.");
+    }
+
+    return (!dp_q.empty());
+}
+
+/**
+ * The flag \p cancel is polled between the stages of witness construction
+ * and between the odd cuts of the Gomory-Hu tree, so a search that is no
+ * longer needed gives up its thread promptly. Cuts found before the flag
+ * was set are kept in \p dp_q.
+ */
+bool DPwitness::simple_DP_sep(CutQueue<dominoparity> &dp_q,
+                              const std::atomic<bool> &cancel)
+{
+    try {
+        build_light_tree();
+        if (cancel) return false;
+
+        add_web_edges();
+        if (cancel) return false;
+
+        build_gh_tree();
+        if (CC_gh_q.empty() || cancel) return false;
+
+        grab_dominos(dp_q, &cancel);
     } catch (const exception &e) {
         cerr << e.what() << "\n";
         throw runtime_error("Problem in DPwitness::simple_DP_sep.");
@@ -211,12 +239,20 @@ void DPwitness::build_gh_tree()
     } CMR_CATCH_PRINT_THROW("dfsing tree for odd cuts", err);
 }
 
-void DPwitness::grab_dominos(CutQueue<dominoparity> &dp_q)
+/**
+ * @param dp_q the queue where simple DP inequalities will be stored.
+ * @param cancel if not null, stop when the pointed-to flag becomes true.
+ */
+void DPwitness::grab_dominos(CutQueue<dominoparity> &dp_q,
+                             const std::atomic<bool> *cancel)
 {
     runtime_error err("Problem in DPwitness::grab_dominos");
     int special_ind = cutgraph_nodes.size() - 1;
 
     while (!CC_gh_q.empty()) {
+        if (cancel && *cancel)
+            break;
+
         vector<int> cut_shore_nodes;
 
         try { expand_cut(CC_gh_q.peek_front(), cut_shore_nodes); }